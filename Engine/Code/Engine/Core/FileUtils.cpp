@@ -47,6 +47,19 @@ bool FileWriteFromBuffer(std::vector<uint8_t> const& buffer, std::string const&
 	return true;
 }
 
+bool FileAppendFromBuffer(std::vector<uint8_t> const& buffer, std::string const& filePathName)
+{
+	FILE* file = nullptr;
+	errno_t result = fopen_s(&file, filePathName.c_str(), "ab");
+	if (result != 0 || file == nullptr)
+	{
+		return false;
+	}
+	fwrite(buffer.data(), 1, buffer.size(), file);
+	fclose(file);
+	return true;
+}
+
 bool CreateFolder(std::string const& folderPathName)
 {
 	return CreateDirectoryA(folderPathName.c_str(), nullptr);
@@ -301,6 +314,29 @@ void BufferWriter::AppendVec4(Vec4 const& vecToAppend)
 	AppendFloat(vecToAppend.w);
 }
 
+void BufferWriter::AppendDoubleVec3(DoubleVec3 const& vecToAppend)
+{
+	AppendDouble(vecToAppend.x);
+	AppendDouble(vecToAppend.y);
+	AppendDouble(vecToAppend.z);
+}
+
+void BufferWriter::AppendDoubleQuaternion(DoubleQuaternion const& quatToAppend)
+{
+	AppendDouble(quatToAppend.i);
+	AppendDouble(quatToAppend.j);
+	AppendDouble(quatToAppend.k);
+	AppendDouble(quatToAppend.w);
+}
+
+void BufferWriter::AppendDoubleMat44(DoubleMat44 const& matToAppend)
+{
+	for (int i = 0; i < 16; i++)
+	{
+		AppendDouble(matToAppend.m_values[i]);
+	}
+}
+
 void BufferWriter::AppendIntVec2(IntVec2 const& vecToAppend)
 {
 	AppendInt32(vecToAppend.x);
@@ -638,6 +674,35 @@ Vec4 BufferParser::ParseVec4()
 	return value;
 }
 
+DoubleVec3 BufferParser::ParseDoubleVec3()
+{
+	DoubleVec3 value;
+	value.x = ParseDouble();
+	value.y = ParseDouble();
+	value.z = ParseDouble();
+	return value;
+}
+
+DoubleQuaternion BufferParser::ParseDoubleQuaternion()
+{
+	DoubleQuaternion value;
+	value.i = ParseDouble();
+	value.j = ParseDouble();
+	value.k = ParseDouble();
+	value.w = ParseDouble();
+	return value;
+}
+
+DoubleMat44 BufferParser::ParseDoubleMat44()
+{
+	DoubleMat44 value;
+	for (int i = 0; i < 16; i++)
+	{
+		value.m_values[i] = ParseDouble();
+	}
+	return value;
+}
+
 IntVec2 BufferParser::ParseIntVec2()
 {
 	IntVec2 value;
@@ -2,12 +2,14 @@
 #include <vector>
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/DoubleQuaternion.hpp"
 #include "Engine/Core/EventSystem.hpp"
 
 
 int FileReadToBuffer(std::vector<uint8_t>& outBuffer, const std::string& fileName);
 int FileReadToString(std::string& outString, const std::string& fileName);
 bool FileWriteFromBuffer(std::vector<uint8_t> const& buffer, std::string const& filePathName);
+bool FileAppendFromBuffer(std::vector<uint8_t> const& buffer, std::string const& filePathName);
 bool CreateFolder(std::string const& folderPathName);
 bool HasFile(std::string const& folderPathName);
 void WriteBufferToFile(std::vector<uint8_t> const& buffer, std::string const& filename);
@@ -45,6 +47,9 @@ public:
 	void AppendVec2(Vec2 const& vecToAppend);
 	void AppendVec3(Vec3 const& vecToAppend);
 	void AppendVec4(Vec4 const& vecToAppend);
+	void AppendDoubleVec3(DoubleVec3 const& vecToAppend);
+	void AppendDoubleQuaternion(DoubleQuaternion const& quatToAppend);
+	void AppendDoubleMat44(DoubleMat44 const& matToAppend);
 	void AppendIntVec2(IntVec2 const& vecToAppend);
 	void AppendIntVec3(IntVec3 const& vecToAppend);
 	void AppendIntVec4(IntVec4 const& vecToAppend);
@@ -90,6 +95,9 @@ public:
 	Vec2 ParseVec2();
 	Vec3 ParseVec3();
 	Vec4 ParseVec4();
+	DoubleVec3 ParseDoubleVec3();
+	DoubleQuaternion ParseDoubleQuaternion();
+	DoubleMat44 ParseDoubleMat44();
 	IntVec2 ParseIntVec2();
 	IntVec3 ParseIntVec3();
 	IntVec4 ParseIntVec4();
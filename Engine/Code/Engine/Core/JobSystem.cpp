@@ -1,32 +1,333 @@
+#ifdef _WIN32
+#define PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#endif
+
 #include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
+
+static thread_local JobWorker* t_currentWorker = nullptr;
+static thread_local int t_jobDepth = 0;		// jobs executing on this thread, counting ones run while waiting
+
+//------------------------------------------------------------------------------------------------
+// PLATFORM THREAD CONTROL
+
+#if !defined(PLATFORM_WINDOWS)
+static int ReadTopologyValue(int core, char const* name, int fallback)
+{
+	std::ifstream file(Stringf("/sys/devices/system/cpu/cpu%d/topology/%s", core, name));
+	int value = fallback;
+	if (!(file >> value))
+	{
+		return fallback;
+	}
+	return value;
+}
+#endif
+
+std::vector<int> GetJobSystemCoreCandidates(bool skipSMTSiblings)
+{
+	std::vector<int> cores;
+
+#if defined(PLATFORM_WINDOWS)
+	// Only the first processor group, which is every core on machines with 64 or fewer
+	DWORD length = 0;
+	GetLogicalProcessorInformation(nullptr, &length);
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (!infos.empty() && GetLogicalProcessorInformation(infos.data(), &length))
+	{
+		std::vector<ULONG_PTR> packageMasks;
+		for (auto const& info : infos)
+		{
+			if (info.Relationship == RelationProcessorPackage) packageMasks.push_back(info.ProcessorMask);
+		}
+		if (packageMasks.empty()) packageMasks.push_back(~(ULONG_PTR)0);
+
+		for (ULONG_PTR packageMask : packageMasks)
+		{
+			for (auto const& info : infos)
+			{
+				if (info.Relationship != RelationProcessorCore || (info.ProcessorMask & packageMask) == 0) continue;
+
+				for (int bit = 0; bit < (int)sizeof(ULONG_PTR) * 8; bit++)
+				{
+					if ((info.ProcessorMask & ((ULONG_PTR)1 << bit)) == 0) continue;
+					cores.push_back(bit);
+					if (skipSMTSiblings) break;
+				}
+			}
+		}
+	}
+#else
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+	{
+		struct CoreTopology
+		{
+			int m_package = 0;
+			int m_physicalCore = 0;
+			int m_logicalCore = 0;
+		};
+		std::vector<CoreTopology> topology;
+		for (int core = 0; core < CPU_SETSIZE; core++)
+		{
+			if (!CPU_ISSET(core, &allowed)) continue;
+			topology.push_back({ ReadTopologyValue(core, "physical_package_id", 0), ReadTopologyValue(core, "core_id", core), core });
+		}
+
+		std::sort(topology.begin(), topology.end(), [](CoreTopology const& a, CoreTopology const& b)
+		{
+			if (a.m_package != b.m_package) return a.m_package < b.m_package;
+			if (a.m_physicalCore != b.m_physicalCore) return a.m_physicalCore < b.m_physicalCore;
+			return a.m_logicalCore < b.m_logicalCore;
+		});
+
+		for (size_t i = 0; i < topology.size(); i++)
+		{
+			bool isSibling = i > 0 && topology[i].m_package == topology[i - 1].m_package && topology[i].m_physicalCore == topology[i - 1].m_physicalCore;
+			if (skipSMTSiblings && isSibling) continue;
+			cores.push_back(topology[i].m_logicalCore);
+		}
+	}
+#endif
+
+	if (cores.empty())
+	{
+		for (int core = 0; core < (int)std::thread::hardware_concurrency(); core++)
+		{
+			cores.push_back(core);
+		}
+	}
+	return cores;
+}
+
+static void PinCurrentThreadToCore(int core)
+{
+#if defined(PLATFORM_WINDOWS)
+	SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#else
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(core, &cpuSet);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+}
+
+static void SetCurrentThreadName(std::string const& name)
+{
+#if defined(PLATFORM_WINDOWS)
+	std::wstring wideName(name.begin(), name.end());
+	SetThreadDescription(GetCurrentThread(), wideName.c_str());
+#else
+	// Linux caps thread names at 15 characters
+	pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+void Job::AddDependency(Job* prerequisite)
+{
+	JobState prerequisiteState = prerequisite->m_state;
+	if (prerequisiteState == JobState::COMPLETED || prerequisiteState == JobState::RETRIEVED)
+	{
+		return;
+	}
+	if (prerequisiteState != JobState::NEW || m_state != JobState::NEW)
+	{
+		ERROR_AND_DIE("Job dependencies must be added before either job is queued");
+	}
+
+	m_numBlockers++;
+	prerequisite->m_continuations.push_back(this);
+}
+
+void Job::AddContinuation(Job* continuation)
+{
+	continuation->AddDependency(this);
+}
+
+//------------------------------------------------------------------------------------------------
+WorkStealingDeque::RingBuffer::RingBuffer(int64_t capacity)
+	:m_capacity(capacity), m_mask(capacity - 1)
+{
+	m_slots = new std::atomic<Job*>[capacity];
+}
+
+WorkStealingDeque::RingBuffer::~RingBuffer()
+{
+	delete[] m_slots;
+}
+
+WorkStealingDeque::WorkStealingDeque(int64_t initialCapacity)
+{
+	m_ring.store(new RingBuffer(initialCapacity), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque()
+{
+	delete m_ring.load(std::memory_order_relaxed);
+	for (auto& ring : m_retiredRings)
+	{
+		delete ring;
+	}
+}
+
+void WorkStealingDeque::Push(Job* job)
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	int64_t top = m_top.load(std::memory_order_acquire);
+	RingBuffer* ring = m_ring.load(std::memory_order_relaxed);
+
+	if (bottom - top > ring->m_capacity - 1)
+	{
+		ring = Grow(ring, top, bottom);
+	}
+
+	ring->Put(bottom, job);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+Job* WorkStealingDeque::Pop()
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	RingBuffer* ring = m_ring.load(std::memory_order_relaxed);
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = ring->Get(bottom);
+	if (top == bottom)
+	{
+		// Last job left: race any thief for it
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = nullptr;
+		}
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job* WorkStealingDeque::Steal()
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+	{
+		return nullptr;
+	}
+
+	// The job may not be dereferenced until the CAS succeeds; the owner could have run it already
+	RingBuffer* ring = m_ring.load(std::memory_order_acquire);
+	Job* job = ring->Get(top);
+
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+	return job;
+}
+
+size_t WorkStealingDeque::GetSize() const
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+	return (bottom > top) ? (size_t)(bottom - top) : 0;
+}
+
+WorkStealingDeque::RingBuffer* WorkStealingDeque::Grow(RingBuffer* ring, int64_t top, int64_t bottom)
+{
+	RingBuffer* bigger = new RingBuffer(ring->m_capacity * 2);
+	for (int64_t i = top; i < bottom; i++)
+	{
+		bigger->Put(i, ring->Get(i));
+	}
+
+	m_retiredRings.push_back(ring);
+	m_ring.store(bigger, std::memory_order_release);
+	return bigger;
+}
 
+//------------------------------------------------------------------------------------------------
 JobWorker::JobWorker(int id, JobSystem* system)
 {
 	m_id = id;
 	m_system = system;
-	m_thread = new std::thread(&JobWorker::ThreadMain, this);
+	m_nextVictim = id + 1;
 }
 
 JobWorker::~JobWorker()
 {
-	m_thread->join();
+	if (m_thread && m_thread->joinable())
+	{
+		m_thread->join();
+	}
+	delete m_thread;
+}
+
+void JobWorker::Start()
+{
+	m_thread = new std::thread(&JobWorker::ThreadMain, this);
 }
 
 void JobWorker::ThreadMain()
 {
+	t_currentWorker = this;
+	SetCurrentThreadName(Stringf("%s %d", m_system->m_config.m_threadNamePrefix.c_str(), m_id));
+	if (m_core >= 0)
+	{
+		PinCurrentThreadToCore(m_core);
+	}
+	int spins = 0;
+
 	while (!m_system->m_isShuttingDown)
 	{
+		unsigned int wakeEpoch = m_system->m_wakeEpoch.load();
 		Job* jobToExecute = m_system->ClaimJob(this);
 		if (jobToExecute)
 		{
-			jobToExecute->Execute();
-			m_system->CompleteJob(jobToExecute);
+			if (spins > 0)
+			{
+				m_spinLimit = std::min(m_spinLimit * 2, JOB_WORKER_MAX_SPINS);
+			}
+			spins = 0;
+
+			m_system->ExecuteJob(jobToExecute, m_counters);
+			continue;
 		}
-		else
+
+		if (spins < m_spinLimit)
 		{
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
+			spins++;
+			std::this_thread::yield();
+			continue;
 		}
+
+		m_spinLimit = std::max(m_spinLimit / 2, JOB_WORKER_MIN_SPINS);
+		spins = 0;
+		m_counters.m_parks++;
+		m_system->ParkWorker(wakeEpoch);
 	}
+
+	t_currentWorker = nullptr;
 }
 
 JobSystem::JobSystem(JobSystemConfig config)
@@ -37,16 +338,30 @@ JobSystem::JobSystem(JobSystemConfig config)
 
 void JobSystem::Startup()
 {
+	m_startTime = GetCurrentTimeSeconds();
+
+	// Reserved cores come off the front, where the OS usually starts the main thread
+	std::vector<int> cores = GetJobSystemCoreCandidates(m_config.m_skipSMTSiblings);
+	int numReserved = std::min(std::max(m_config.m_numReservedCores, 0), (int)cores.size());
+	m_workerCores.assign(cores.begin() + numReserved, cores.end());
+
 	if (m_config.m_numWorkers < 0)
 	{
-		m_config.m_numWorkers = std::thread::hardware_concurrency() - 1;
+		m_config.m_numWorkers = (int)m_workerCores.size();
 	}
 	CreateWorkers(m_config.m_numWorkers);
+
+	if (m_config.m_pinWorkers)
+	{
+		DebuggerPrintf("JobSystem: %d workers pinned to %d of %d usable cores\n", m_config.m_numWorkers, (int)m_workerCores.size(), (int)cores.size());
+	}
 }
 
 void JobSystem::BeginFrame()
 {
-
+	JobSystemStats stats = GetStats();
+	m_frameStats = stats.GetDelta(m_frameStartStats);
+	m_frameStartStats = stats;
 }
 
 void JobSystem::EndFrame()
@@ -57,20 +372,45 @@ void JobSystem::EndFrame()
 void JobSystem::Shutdown()
 {
 	m_isShuttingDown = true;
+	{
+		std::lock_guard<std::mutex> lock(m_parkMutex);
+	}
+	m_parkCondition.notify_all();
 	DestroyWorkers();
 }
 
+// Workers steal from each other by walking m_workers, so the list is complete before any thread starts
 void JobSystem::CreateWorkers(int num)
 {
+	size_t firstNewWorker = m_workers.size();
 	for (int i = 0; i < num; i++)
 	{
-		JobWorker* newWorker = new JobWorker(i, this);
+		JobWorker* newWorker = new JobWorker((int)m_workers.size(), this);
+		if (m_config.m_pinWorkers && !m_workerCores.empty())
+		{
+			// More workers than cores wrap around and share
+			newWorker->m_core = m_workerCores[newWorker->m_id % m_workerCores.size()];
+		}
 		m_workers.push_back(newWorker);
 	}
+
+	for (size_t i = firstNewWorker; i < m_workers.size(); i++)
+	{
+		m_workers[i]->Start();
+	}
 }
 
 void JobSystem::DestroyWorkers()
 {
+	// Join everyone before freeing anything, since a running worker may still be stealing from another
+	for (auto & worker : m_workers)
+	{
+		if (worker->m_thread && worker->m_thread->joinable())
+		{
+			worker->m_thread->join();
+		}
+	}
+
 	for (auto & worker : m_workers)
 	{
 		delete worker;
@@ -87,137 +427,439 @@ size_t JobSystem::GetWorkersSize() const
 
 void JobSystem::QueueJob(Job* jobToQueue)
 {
-	m_queuedJobsMutex.lock();
 	jobToQueue->m_state = JobState::QUEUED;
-	m_queuedJobs.push_back(jobToQueue);
-	m_queuedJobsMutex.unlock();
+
+	// Drop the submission blocker; whoever takes the count to zero, here or in CompleteJob, enqueues it
+	if (jobToQueue->m_numBlockers.fetch_sub(1) == 1)
+	{
+		EnqueueReadyJob(jobToQueue);
+	}
 }
 
-Job* JobSystem::ClaimJob(JobWorker* worker)
+void JobSystem::EnqueueReadyJob(Job* jobToQueue)
 {
-	m_queuedJobsMutex.lock();
+	m_numQueuedJobs++;
+	jobToQueue->m_readyTime = GetCurrentTimeSeconds();
 
-	if (m_queuedJobs.empty())
+	// Jobs spawned from inside a job stay on that worker's deque, where they are cheapest to run
+	JobWorker* worker = t_currentWorker;
+	if (worker && worker->m_system == this && (jobToQueue->m_Bitflags & worker->m_jobTypeBitflags) != 0)
 	{
-		m_queuedJobsMutex.unlock();
-		return nullptr;
+		worker->m_deques[(int)jobToQueue->m_priority].Push(jobToQueue);
+	}
+	else
+	{
+		PostJobToWorker(jobToQueue);
 	}
 
-	Job* job = m_queuedJobs.front();
+	WakeWorker();
+}
+
+void JobSystem::ParkWorker(unsigned int wakeEpoch)
+{
+	std::unique_lock<std::mutex> lock(m_parkMutex);
+	m_numParkedWorkers++;
+	m_parkCondition.wait(lock, [this, wakeEpoch]() { return m_wakeEpoch.load() != wakeEpoch || m_isShuttingDown; });
+	m_numParkedWorkers--;
+}
 
-	if ((job->m_Bitflags & worker->m_jobTypeBitflags) == 0)
+// Bumping the epoch first means a worker that is about to park sees it and stays up; one that is
+// already parked is counted, so only then do we pay for the lock and the notify.
+void JobSystem::WakeWorker()
+{
+	m_wakeEpoch++;
+	if (m_numParkedWorkers.load() > 0)
 	{
-		m_queuedJobsMutex.unlock();
-		return nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_parkMutex);
+		}
+		m_parkCondition.notify_one();
+	}
+}
+
+void JobSystem::PostJobToWorker(Job* job)
+{
+	JobWorker* worker = FindWorkerForJob(job);
+	if (worker)
+	{
+		worker->m_inboxMutex.lock();
+		worker->m_inbox.push_back(job);
+		worker->m_inboxSize++;
+		worker->m_inboxMutex.unlock();
+		return;
 	}
 
-	m_queuedJobs.pop_front();
+	unsigned int bitflags = job->m_Bitflags;
+	std::vector<JobLane>& lanes = m_sharedLanes[(int)job->m_priority];
+	m_queuedJobsMutex.lock();
+	JobLane* lane = nullptr;
+	for (JobLane& candidate : lanes)
+	{
+		if (candidate.m_bitflags == bitflags)
+		{
+			lane = &candidate;
+			break;
+		}
+	}
+	if (!lane)
+	{
+		lanes.push_back(JobLane());
+		lane = &lanes.back();
+		lane->m_bitflags = bitflags;
+	}
+	lane->m_jobs.push_back(job);
+	m_numSharedJobs++;
 	m_queuedJobsMutex.unlock();
+}
+
+JobWorker* JobSystem::FindWorkerForJob(Job* job)
+{
+	size_t numWorkers = m_workers.size();
+	if (numWorkers == 0) return nullptr;
+
+	unsigned int start = m_nextWorker.fetch_add(1, std::memory_order_relaxed);
+	for (size_t i = 0; i < numWorkers; i++)
+	{
+		JobWorker* worker = m_workers[(start + i) % numWorkers];
+		if ((job->m_Bitflags & worker->m_jobTypeBitflags) != 0)
+		{
+			return worker;
+		}
+	}
+	return nullptr;
+}
+
+// Highest priority first, and within a priority the cheapest source first: our own deque, then
+// other workers, then the shared lanes
+Job* JobSystem::ClaimJob(JobWorker* worker, JobPriority lowestPriorityToRun)
+{
+	if (worker->m_inboxSize.load(std::memory_order_relaxed) > 0)
+	{
+		DrainInbox(worker);
+	}
+
+	unsigned int bitflags = worker->m_jobTypeBitflags;
+	Job* job = nullptr;
+	for (int priority = 0; priority <= (int)lowestPriorityToRun && !job; priority++)
+	{
+		job = worker->m_deques[priority].Pop();
+		if (!job)
+		{
+			job = StealJob(worker, bitflags, priority);
+		}
+		if (!job)
+		{
+			job = PopSharedQueue(bitflags, priority);
+		}
+	}
 
+	if (!job)
+	{
+		return nullptr;
+	}
+
+	m_numQueuedJobs--;
 	job->m_state = JobState::EXECUTING;
+	return job;
+}
 
-	m_executingJobsMutex.lock();
-	m_executingJobs.push_back(job);
-	m_executingJobsMutex.unlock();
+void JobSystem::DrainInbox(JobWorker* worker)
+{
+	worker->m_inboxMutex.lock();
+	for (Job* job : worker->m_inbox)
+	{
+		worker->m_deques[(int)job->m_priority].Push(job);
+	}
+	worker->m_inbox.clear();
+	worker->m_inboxSize = 0;
+	worker->m_inboxMutex.unlock();
+}
 
+Job* JobSystem::PopSharedQueue(unsigned int bitflags, int priority)
+{
+	if (m_numSharedJobs.load(std::memory_order_relaxed) == 0) return nullptr;
+
+	Job* job = nullptr;
+	m_queuedJobsMutex.lock();
+	for (JobLane& lane : m_sharedLanes[priority])
+	{
+		if ((lane.m_bitflags & bitflags) != 0 && !lane.m_jobs.empty())
+		{
+			job = lane.m_jobs.front();
+			lane.m_jobs.pop_front();
+			m_numSharedJobs--;
+			break;
+		}
+	}
+	m_queuedJobsMutex.unlock();
 	return job;
 }
 
+// thief is null when a thread outside the pool is helping out
+Job* JobSystem::StealJob(JobWorker* thief, unsigned int bitflags, int priority)
+{
+	JobThreadCounters& counters = thief ? thief->m_counters : m_helperCounters;
+	size_t numWorkers = m_workers.size();
+	int firstVictim = thief ? thief->m_nextVictim : 0;
+	for (size_t i = 0; i < numWorkers; i++)
+	{
+		JobWorker* victim = m_workers[(firstVictim + i) % numWorkers];
+		if (victim == thief) continue;
+
+		counters.m_stealAttempts++;
+		Job* job = victim->m_deques[priority].Steal();
+		if (job && (job->m_Bitflags & bitflags) == 0)
+		{
+			// Not ours to run; hand it to a worker that accepts it instead of back into a deque we don't own
+			PostJobToWorker(job);
+			WakeWorker();
+			continue;
+		}
+		if (job)
+		{
+			// Keep going back to a victim that had work; it likely has more
+			if (thief) thief->m_nextVictim = victim->m_id;
+			counters.m_steals++;
+			return job;
+		}
+	}
+
+	// A woken worker may not be the one whose inbox got the job, so inboxes are fair game too. Any
+	// matching job in there will do, not just the one at the front.
+	for (size_t i = 0; i < numWorkers; i++)
+	{
+		JobWorker* victim = m_workers[(firstVictim + i) % numWorkers];
+		if (victim == thief || victim->m_inboxSize.load(std::memory_order_relaxed) == 0) continue;
+		counters.m_stealAttempts++;
+		if (!victim->m_inboxMutex.try_lock()) continue;
+
+		Job* job = nullptr;
+		for (auto it = victim->m_inbox.begin(); it != victim->m_inbox.end(); ++it)
+		{
+			if ((int)(*it)->m_priority == priority && ((*it)->m_Bitflags & bitflags) != 0)
+			{
+				job = *it;
+				victim->m_inbox.erase(it);
+				victim->m_inboxSize--;
+				break;
+			}
+		}
+		victim->m_inboxMutex.unlock();
+
+		if (job)
+		{
+			counters.m_steals++;
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+// Once the counter drops or the job reaches the completed list its owner may delete it, so
+// everything that reads the job happens before either of those
 void JobSystem::CompleteJob(Job* jobToComplete)
 {
-	m_executingJobsMutex.lock();
+	JobCounter* counter = jobToComplete->m_completionCounter;
+	bool isRetrievable = jobToComplete->m_isRetrievable;
 
-	for (size_t i = 0; i < m_executingJobs.size(); i++)
+	jobToComplete->m_numBlockers = 1;
+	jobToComplete->m_state = JobState::COMPLETED;
+
+	for (Job* continuation : jobToComplete->m_continuations)
 	{
-		if (m_executingJobs[i] == jobToComplete)
+		if (continuation->m_numBlockers.fetch_sub(1) == 1)
 		{
-			m_executingJobs.erase(m_executingJobs.begin() + i);
-			m_executingJobsMutex.unlock();
-			m_completedJobsMutex.lock();
-			jobToComplete->m_state = JobState::COMPLETED;
-			m_completedJobs.push_back(jobToComplete);
-			m_completedJobsMutex.unlock();
-			return;
+			EnqueueReadyJob(continuation);
 		}
 	}
+	jobToComplete->m_continuations.clear();
+
+	if (counter)
+	{
+		counter->m_count--;
+	}
+
+	if (isRetrievable)
+	{
+		// Count first: once the job is on the stack a retriever may take and delete it
+		m_numCompletedJobs++;
+		Job* head = m_completedStack.load(std::memory_order_relaxed);
+		do
+		{
+			jobToComplete->m_nextCompleted = head;
+		} while (!m_completedStack.compare_exchange_weak(head, jobToComplete, std::memory_order_release, std::memory_order_relaxed));
+	}
+}
+
+// Takes everything pushed so far in one exchange, so there is no ABA, then appends it to the
+// retrieve list in completion order. Callers hold m_retrieveMutex.
+void JobSystem::DrainCompletedJobs()
+{
+	Job* newest = m_completedStack.exchange(nullptr, std::memory_order_acquire);
+
+	Job* oldest = nullptr;
+	while (newest)
+	{
+		Job* next = newest->m_nextCompleted;
+		newest->m_nextCompleted = oldest;
+		oldest = newest;
+		newest = next;
+	}
 
-	m_executingJobsMutex.unlock();
-	return;
+	for (Job* job = oldest; job; job = job->m_nextCompleted)
+	{
+		job->m_prevCompleted = m_retrieveTail;
+		job->m_isInRetrieveList = true;
+		if (m_retrieveTail) m_retrieveTail->m_nextCompleted = job;
+		else m_retrieveHead = job;
+		m_retrieveTail = job;
+	}
 }
 
-Job* JobSystem::RetrieveJob(Job* jobToRetrived)
+void JobSystem::UnlinkRetrievedJob(Job* job)
 {
-	m_completedJobsMutex.lock();
-	if (!m_completedJobs.empty())
+	if (job->m_prevCompleted) job->m_prevCompleted->m_nextCompleted = job->m_nextCompleted;
+	else m_retrieveHead = job->m_nextCompleted;
+	if (job->m_nextCompleted) job->m_nextCompleted->m_prevCompleted = job->m_prevCompleted;
+	else m_retrieveTail = job->m_prevCompleted;
+
+	job->m_nextCompleted = nullptr;
+	job->m_prevCompleted = nullptr;
+	job->m_isInRetrieveList = false;
+	job->m_state = JobState::RETRIEVED;
+	m_numCompletedJobs--;
+}
+
+void JobSystem::Wait(JobCounter const& counter, JobPriority lowestPriorityToRun)
+{
+	unsigned int bitflags = (t_currentWorker && t_currentWorker->m_system == this) ? t_currentWorker->m_jobTypeBitflags.load() : 1;
+	while (!counter.IsDone())
 	{
-		if (jobToRetrived)
+		if (!RunOneJob(bitflags, lowestPriorityToRun))
 		{
-			for (size_t i = 0; i < m_completedJobs.size(); i++)
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::RunOneJob(unsigned int bitflags, JobPriority lowestPriorityToRun)
+{
+	Job* job = nullptr;
+	JobWorker* worker = t_currentWorker;
+	if (worker && worker->m_system == this)
+	{
+		job = ClaimJob(worker, lowestPriorityToRun);
+	}
+	else
+	{
+		for (int priority = 0; priority <= (int)lowestPriorityToRun && !job; priority++)
+		{
+			job = StealJob(nullptr, bitflags, priority);
+			if (!job)
 			{
-				if (m_completedJobs[i] == jobToRetrived)
-				{
-					m_completedJobs.erase(m_completedJobs.begin() + i);
-					jobToRetrived->m_state = JobState::RETRIEVED;
-					m_completedJobsMutex.unlock();
-					return jobToRetrived;
-				}
+				job = PopSharedQueue(bitflags, priority);
 			}
 		}
-		else
+		if (job)
 		{
-			Job* firstFinishedJob = m_completedJobs.front();
-			m_completedJobs.pop_front();
-			m_completedJobsMutex.unlock();
-			return firstFinishedJob;
+			m_numQueuedJobs--;
+			job->m_state = JobState::EXECUTING;
 		}
 	}
 
-	m_completedJobsMutex.unlock();
-	return nullptr;
+	if (!job)
+	{
+		return false;
+	}
+
+	ExecuteJob(job, GetLocalCounters());
+	return true;
 }
 
-size_t JobSystem::GetNumQueuedJobs() const
+void JobSystem::ExecuteJob(Job* job, JobThreadCounters& counters)
 {
-	m_queuedJobsMutex.lock();
-	size_t numQueuedJob = m_queuedJobs.size();
-	m_queuedJobsMutex.unlock();
-	return numQueuedJob;
+	double startTime = GetCurrentTimeSeconds();
+	double latency = std::max(startTime - job->m_readyTime, 0.0);
+	counters.m_queueLatencyMicroseconds += (uint64_t)(latency * 1000000.0);
+	counters.m_queueLatencyHistogram[JobThreadStats::GetLatencyBucket(latency)]++;
+	counters.m_jobsExecuted++;
+
+	t_jobDepth++;
+	job->Execute();
+	t_jobDepth--;
+
+	if (t_jobDepth == 0)
+	{
+		counters.m_busyMicroseconds += (uint64_t)((GetCurrentTimeSeconds() - startTime) * 1000000.0);
+	}
+	CompleteJob(job);
 }
 
-size_t JobSystem::GetNumCompletedJobs() const
+JobThreadCounters& JobSystem::GetLocalCounters()
 {
-	m_completedJobsMutex.lock();
-	size_t numCompletedJob = m_completedJobs.size();
-	m_completedJobsMutex.unlock();
-	return numCompletedJob;
+	JobWorker* worker = t_currentWorker;
+	if (worker && worker->m_system == this)
+	{
+		return worker->m_counters;
+	}
+	return m_helperCounters;
 }
 
-void JobSystem::ClearAllJobs()
+JobSystemStats JobSystem::GetStats() const
 {
-	m_queuedJobsMutex.lock();
-	m_executingJobsMutex.lock();
-	m_completedJobsMutex.lock();
+	JobSystemStats stats;
+	stats.m_wallSeconds = GetCurrentTimeSeconds() - m_startTime;
+	stats.m_workers.reserve(m_workers.size());
+	for (JobWorker const* worker : m_workers)
+	{
+		stats.m_workers.push_back(worker->m_counters.GetSnapshot());
+	}
+	stats.m_helpers = m_helperCounters.GetSnapshot();
+	return stats;
+}
 
-	for (auto & queuedJob : m_queuedJobs)
+JobSystemStats const& JobSystem::GetFrameStats() const
+{
+	return m_frameStats;
+}
+
+Job* JobSystem::RetrieveJob(Job* jobToRetrived)
+{
+	std::lock_guard<std::mutex> lock(m_retrieveMutex);
+
+	if (jobToRetrived)
 	{
-		delete queuedJob;
+		if (!jobToRetrived->m_isInRetrieveList)
+		{
+			if (jobToRetrived->m_state != JobState::COMPLETED) return nullptr;
+			DrainCompletedJobs();
+			if (!jobToRetrived->m_isInRetrieveList) return nullptr;
+		}
+		UnlinkRetrievedJob(jobToRetrived);
+		return jobToRetrived;
 	}
-	for (auto & executingJob : m_executingJobs)
+
+	if (!m_retrieveHead)
 	{
-		delete executingJob;
+		DrainCompletedJobs();
 	}
-	for (auto & completedJob : m_completedJobs)
+
+	Job* firstFinishedJob = m_retrieveHead;
+	if (firstFinishedJob)
 	{
-		delete completedJob;
+		UnlinkRetrievedJob(firstFinishedJob);
 	}
+	return firstFinishedJob;
+}
 
-	m_queuedJobs.clear();
-	m_executingJobs.clear();
-	m_completedJobs.clear();
+size_t JobSystem::GetNumQueuedJobs() const
+{
+	return m_numQueuedJobs;
+}
 
-	m_queuedJobsMutex.unlock();
-	m_executingJobsMutex.unlock();
-	m_completedJobsMutex.unlock();
+size_t JobSystem::GetNumCompletedJobs() const
+{
+	return m_numCompletedJobs;
 }
 
 void JobSystem::SetWorkerThreadJobFlags(unsigned int bitflags, int num)
@@ -238,3 +880,310 @@ void JobSystem::SetWorkerThreadJobFlags(unsigned int bitflags, int num)
 	}
 
 }
+
+//------------------------------------------------------------------------------------------------
+// TELEMETRY
+
+void JobThreadStats::Add(JobThreadStats const& other)
+{
+	m_busySeconds += other.m_busySeconds;
+	m_jobsExecuted += other.m_jobsExecuted;
+	m_stealAttempts += other.m_stealAttempts;
+	m_steals += other.m_steals;
+	m_parks += other.m_parks;
+	m_queueLatencySeconds += other.m_queueLatencySeconds;
+	for (int i = 0; i < JOB_LATENCY_BUCKETS; i++)
+	{
+		m_queueLatencyHistogram[i] += other.m_queueLatencyHistogram[i];
+	}
+}
+
+void JobThreadStats::Subtract(JobThreadStats const& other)
+{
+	m_busySeconds -= other.m_busySeconds;
+	m_jobsExecuted -= other.m_jobsExecuted;
+	m_stealAttempts -= other.m_stealAttempts;
+	m_steals -= other.m_steals;
+	m_parks -= other.m_parks;
+	m_queueLatencySeconds -= other.m_queueLatencySeconds;
+	for (int i = 0; i < JOB_LATENCY_BUCKETS; i++)
+	{
+		m_queueLatencyHistogram[i] -= other.m_queueLatencyHistogram[i];
+	}
+}
+
+double JobThreadStats::GetAverageQueueLatencyMicroseconds() const
+{
+	if (m_jobsExecuted == 0) return 0.0;
+	return m_queueLatencySeconds * 1000000.0 / (double)m_jobsExecuted;
+}
+
+int JobThreadStats::GetLatencyBucket(double latencySeconds)
+{
+	double microseconds = latencySeconds * 1000000.0;
+	int bucket = 0;
+	while (bucket < JOB_LATENCY_BUCKETS - 1 && microseconds >= (double)(1ull << bucket))
+	{
+		bucket++;
+	}
+	return bucket;
+}
+
+JobThreadStats JobSystemStats::GetTotal() const
+{
+	JobThreadStats total = m_helpers;
+	for (JobThreadStats const& worker : m_workers)
+	{
+		total.Add(worker);
+	}
+	return total;
+}
+
+double JobSystemStats::GetWorkerUtilization(int workerIndex) const
+{
+	if (m_wallSeconds <= 0.0) return 0.0;
+	return m_workers[workerIndex].m_busySeconds / m_wallSeconds;
+}
+
+double JobSystemStats::GetUtilization() const
+{
+	if (m_wallSeconds <= 0.0 || m_workers.empty()) return 0.0;
+
+	double busySeconds = 0.0;
+	for (JobThreadStats const& worker : m_workers)
+	{
+		busySeconds += worker.m_busySeconds;
+	}
+	return busySeconds / (m_wallSeconds * (double)m_workers.size());
+}
+
+// Workers created after the earlier snapshot count from zero
+JobSystemStats JobSystemStats::GetDelta(JobSystemStats const& earlier) const
+{
+	JobSystemStats delta = *this;
+	delta.m_wallSeconds -= earlier.m_wallSeconds;
+	for (size_t i = 0; i < delta.m_workers.size() && i < earlier.m_workers.size(); i++)
+	{
+		delta.m_workers[i].Subtract(earlier.m_workers[i]);
+	}
+	delta.m_helpers.Subtract(earlier.m_helpers);
+	return delta;
+}
+
+JobThreadCounters::JobThreadCounters()
+{
+	for (auto& bucket : m_queueLatencyHistogram)
+	{
+		bucket = 0;
+	}
+}
+
+JobThreadStats JobThreadCounters::GetSnapshot() const
+{
+	JobThreadStats stats;
+	stats.m_busySeconds = (double)m_busyMicroseconds.load() / 1000000.0;
+	stats.m_jobsExecuted = m_jobsExecuted;
+	stats.m_stealAttempts = m_stealAttempts;
+	stats.m_steals = m_steals;
+	stats.m_parks = m_parks;
+	stats.m_queueLatencySeconds = (double)m_queueLatencyMicroseconds.load() / 1000000.0;
+	for (int i = 0; i < JOB_LATENCY_BUCKETS; i++)
+	{
+		stats.m_queueLatencyHistogram[i] = m_queueLatencyHistogram[i];
+	}
+	return stats;
+}
+
+//------------------------------------------------------------------------------------------------
+FunctionJob::~FunctionJob()
+{
+	ClearFunction();
+}
+
+void FunctionJob::ClearFunction()
+{
+	if (m_destroy)
+	{
+		m_destroy(m_storage);
+	}
+	m_invoke = nullptr;
+	m_destroy = nullptr;
+}
+
+void FunctionJob::Execute()
+{
+	m_invoke(m_storage);
+}
+
+JobPool::~JobPool()
+{
+	for (FunctionJob* block : m_blocks)
+	{
+		delete[] block;
+	}
+}
+
+FunctionJob* JobPool::Acquire()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_firstFree)
+	{
+		FunctionJob* block = new FunctionJob[JOB_POOL_BLOCK_SIZE];
+		m_blocks.push_back(block);
+		for (int i = 0; i < JOB_POOL_BLOCK_SIZE; i++)
+		{
+			block[i].m_pool = this;
+			block[i].m_nextFree = (i + 1 < JOB_POOL_BLOCK_SIZE) ? &block[i + 1] : nullptr;
+		}
+		m_firstFree = block;
+	}
+
+	FunctionJob* job = m_firstFree;
+	m_firstFree = job->m_nextFree;
+	job->m_nextFree = nullptr;
+	return job;
+}
+
+void JobPool::Release(FunctionJob* job)
+{
+	job->ClearFunction();
+	job->m_state = JobState::NEW;
+	job->m_Bitflags = 1;
+	job->m_priority = JobPriority::NORMAL;
+	job->m_completionCounter = nullptr;
+	job->m_isRetrievable = true;
+	job->m_numBlockers = 1;
+	job->m_continuations.clear();
+	job->m_nextCompleted = nullptr;
+	job->m_prevCompleted = nullptr;
+	job->m_isInRetrieveList = false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	job->m_nextFree = m_firstFree;
+	m_firstFree = job;
+}
+
+JobPool& JobSystem::GetLocalJobPool()
+{
+	JobWorker* worker = t_currentWorker;
+	if (worker && worker->m_system == this)
+	{
+		return worker->m_jobPool;
+	}
+	return m_externalJobPool;
+}
+
+void JobSystem::ReleaseJob(FunctionJob* job)
+{
+	if (!job) return;
+	job->m_pool->Release(job);
+}
+
+//------------------------------------------------------------------------------------------------
+void ParallelForContext::RunChunks()
+{
+	for (;;)
+	{
+		int rangeBegin = m_nextIndex.fetch_add(m_grain);
+		if (rangeBegin >= m_end) return;
+
+		int rangeEnd = (m_end - rangeBegin < m_grain) ? m_end : rangeBegin + m_grain;
+		m_runRange(m_function, rangeBegin, rangeEnd);
+	}
+}
+
+int JobSystem::GetParallelGrain(int count, int grain) const
+{
+	if (grain > 0) return grain;
+
+	int numThreads = (int)m_workers.size() + 1;
+	return std::max(1, count / (numThreads * JOB_CHUNKS_PER_THREAD));
+}
+
+void JobSystem::RunParallelFor(ParallelForContext& context)
+{
+	int numChunks = (context.m_end - context.m_begin + context.m_grain - 1) / context.m_grain;
+	int numHelpers = std::min(std::min((int)m_workers.size(), numChunks - 1), JOB_MAX_PARALLEL_HELPERS);
+	if (numHelpers <= 0)
+	{
+		context.RunChunks();
+		return;
+	}
+
+	ParallelForJob helpers[JOB_MAX_PARALLEL_HELPERS];
+	ParallelForJob* batch[JOB_MAX_PARALLEL_HELPERS];
+	for (int i = 0; i < numHelpers; i++)
+	{
+		helpers[i].m_context = &context;
+		helpers[i].m_priority = JobPriority::CRITICAL;	// the caller is already blocked on them
+		batch[i] = &helpers[i];
+	}
+
+	JobCounter counter;
+	QueueJobs(batch, numHelpers, counter);
+
+	// Helpers that start after the range is used up just return, but they still have to be waited on
+	context.RunChunks();
+	Wait(counter);
+}
+
+//------------------------------------------------------------------------------------------------
+// BENCHMARK
+class BenchmarkLatencyJob : public Job
+{
+public:
+	void Execute() override { m_startTime = GetCurrentTimeSeconds(); }
+	double m_startTime = 0.0;
+};
+
+static void MeasureQueueToStartLatency(JobSystem* system, bool letWorkersPark, double& out_avgMicroseconds, double& out_maxMicroseconds, int numSamples)
+{
+	double total = 0.0;
+	double worst = 0.0;
+	for (int i = 0; i < numSamples; i++)
+	{
+		if (letWorkersPark)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		BenchmarkLatencyJob job;
+		double queueTime = GetCurrentTimeSeconds();
+		system->QueueJob(&job);
+		while (!system->RetrieveJob(&job))
+		{
+			std::this_thread::yield();
+		}
+
+		double latency = (job.m_startTime - queueTime) * 1000000.0;
+		total += latency;
+		worst = std::max(worst, latency);
+	}
+
+	out_avgMicroseconds = (numSamples > 0) ? total / (double)numSamples : 0.0;
+	out_maxMicroseconds = worst;
+}
+
+// Expects an otherwise idle job system; anything else running skews both numbers
+JobSystemBenchmarkResult RunJobSystemBenchmark(JobSystem* system, double idleSeconds, int numLatencySamples)
+{
+	JobSystemBenchmarkResult result;
+	result.m_idleSeconds = idleSeconds;
+	result.m_numLatencySamples = numLatencySamples;
+
+	double cpuStart = GetProcessCPUTimeSeconds();
+	double wallStart = GetCurrentTimeSeconds();
+	std::this_thread::sleep_for(std::chrono::duration<double>(idleSeconds));
+	double wallSeconds = GetCurrentTimeSeconds() - wallStart;
+	result.m_idleCPUSeconds = GetProcessCPUTimeSeconds() - cpuStart;
+	result.m_idleCores = (wallSeconds > 0.0) ? result.m_idleCPUSeconds / wallSeconds : 0.0;
+
+	if (system->GetWorkersSize() == 0)
+	{
+		return result;
+	}
+
+	MeasureQueueToStartLatency(system, true, result.m_coldLatencyAvgMicroseconds, result.m_coldLatencyMaxMicroseconds, numLatencySamples);
+	MeasureQueueToStartLatency(system, false, result.m_hotLatencyAvgMicroseconds, result.m_hotLatencyMaxMicroseconds, numLatencySamples);
+	return result;
+}
@@ -9,6 +9,31 @@
 #include <atomic>
 #include <future>
 #include <type_traits> 
+#include <cstdint>
+#include <string>
+#include <cstddef>
+#include <new>
+
+// Idle workers spin this many claim attempts before parking. The limit adapts per worker: it grows
+// when work shows up mid-spin and shrinks when a whole spin finds nothing.
+constexpr int JOB_WORKER_MIN_SPINS = 16;
+constexpr int JOB_WORKER_MAX_SPINS = 4096;
+constexpr int JOB_MAX_PARALLEL_HELPERS = 32;	// helper jobs live on the caller's stack, so this caps ParallelFor's frame
+constexpr int JOB_CHUNKS_PER_THREAD = 4;		// automatic grain aims for this many chunks per participating thread
+constexpr int JOB_FUNCTION_STORAGE_SIZE = 64;	// bytes of captures a FunctionJob holds inline
+constexpr int JOB_POOL_BLOCK_SIZE = 64;			// FunctionJobs a pool allocates at once when it runs dry
+constexpr int JOB_LATENCY_BUCKETS = 16;			// bucket i counts queue waits under 2^i microseconds, the last one all longer waits
+
+// Workers always take the most urgent job they can see, so a backlog of background work never
+// delays a critical one queued after it. A job that is already running is never interrupted.
+enum class JobPriority
+{
+	CRITICAL,		// on the frame's critical path, e.g. the physics step
+	NORMAL,
+	BACKGROUND,		// may take many frames, e.g. asset decoding
+	COUNT
+};
+constexpr int NUM_JOB_PRIORITIES = (int)JobPriority::COUNT;
 
 enum class JobState
 {
@@ -20,7 +45,24 @@ enum class JobState
 };
 struct JobSystemConfig
 {
-	int m_numWorkers = -1;
+	int m_numWorkers = -1;					// -1: one per usable core left after the reserved ones
+	bool m_pinWorkers = false;				// bind each worker to its own core instead of letting the OS move it
+	bool m_skipSMTSiblings = false;			// use one logical core per physical core
+	int m_numReservedCores = 1;				// left free for the main and render threads
+	std::string m_threadNamePrefix = "JobWorker";	// workers show up in profilers as <prefix> <id>
+};
+
+// Logical cores this process may run on, ordered by package and then physical core so that consecutive
+// workers share a socket. With skipSMTSiblings only the first logical core of each physical core is kept.
+std::vector<int> GetJobSystemCoreCandidates(bool skipSMTSiblings);
+
+// Counts outstanding jobs and serves as the handle of a batch. JobSystem::QueueJobs adds a batch to it
+// and JobSystem::Wait returns once every job added so far has finished.
+struct JobCounter
+{
+	std::atomic<int> m_count = 0;
+
+	bool IsDone() const { return m_count.load() <= 0; }
 };
 
 struct Job
@@ -29,10 +71,186 @@ struct Job
 	virtual ~Job() = default;
 
 	virtual void Execute() = 0;
+
+	// The graph has to be wired before either job is queued. A queued job with unfinished
+	// prerequisites is held back until the last of them completes.
+	void AddDependency(Job* prerequisite);
+	void AddContinuation(Job* continuation);
+
 	std::atomic<unsigned int> m_Bitflags = 1;
 	std::atomic<JobState> m_state = JobState::NEW;
+	JobPriority m_priority = JobPriority::NORMAL;
+	double m_readyTime = 0.0;					// when it last became runnable, for queue latency
+
+	JobCounter* m_completionCounter = nullptr;	// decremented once this job has finished
+	bool m_isRetrievable = true;				// false: never lands in the completed list, the owner tracks it through its counter
+
+	std::atomic<int> m_numBlockers = 1;			// unfinished prerequisites, plus one until QueueJob is called
+	std::vector<Job*> m_continuations;
+
+	// Intrusive links for the completed list, so finishing and retrieving a job never searches or allocates
+	Job* m_nextCompleted = nullptr;
+	Job* m_prevCompleted = nullptr;
+	bool m_isInRetrieveList = false;
+};
+
+class JobSystem;
+class JobPool;
+
+//------------------------------------------------------------------------------------------------
+// What one thread did with jobs over some span of time. Busy time counts only the outermost job,
+// so a job that helps while it waits is not counted twice.
+struct JobThreadStats
+{
+	double m_busySeconds = 0.0;
+	uint64_t m_jobsExecuted = 0;
+	uint64_t m_stealAttempts = 0;				// victims tried, across deques and inboxes
+	uint64_t m_steals = 0;
+	uint64_t m_parks = 0;
+	double m_queueLatencySeconds = 0.0;			// summed over every job executed
+	uint64_t m_queueLatencyHistogram[JOB_LATENCY_BUCKETS] = {};
+
+	void Add(JobThreadStats const& other);
+	void Subtract(JobThreadStats const& other);
+	double GetAverageQueueLatencyMicroseconds() const;
+	static int GetLatencyBucket(double latencySeconds);
+};
+
+struct JobSystemStats
+{
+	double m_wallSeconds = 0.0;					// span this snapshot covers
+	std::vector<JobThreadStats> m_workers;
+	JobThreadStats m_helpers;					// jobs run by threads outside the pool while they wait
+
+	JobThreadStats GetTotal() const;
+	double GetWorkerUtilization(int workerIndex) const;
+	double GetUtilization() const;				// busy worker time over the worker time available
+	JobSystemStats GetDelta(JobSystemStats const& earlier) const;
+};
+
+// Live counters behind JobThreadStats. Mostly written by one thread, but read by GetStats at any time.
+struct JobThreadCounters
+{
+	std::atomic<uint64_t> m_busyMicroseconds = 0;
+	std::atomic<uint64_t> m_jobsExecuted = 0;
+	std::atomic<uint64_t> m_stealAttempts = 0;
+	std::atomic<uint64_t> m_steals = 0;
+	std::atomic<uint64_t> m_parks = 0;
+	std::atomic<uint64_t> m_queueLatencyMicroseconds = 0;
+	std::atomic<uint64_t> m_queueLatencyHistogram[JOB_LATENCY_BUCKETS];
+
+	JobThreadCounters();
+	JobThreadStats GetSnapshot() const;
 };
 
+//------------------------------------------------------------------------------------------------
+// Runs a callable stored inside the job itself. Captures must fit in JOB_FUNCTION_STORAGE_SIZE bytes,
+// so a FunctionJob taken from a JobPool costs no allocation to fill, queue or give back.
+class FunctionJob : public Job
+{
+	friend class JobPool;
+	friend class JobSystem;
+
+public:
+	FunctionJob() = default;
+	~FunctionJob();
+	FunctionJob(FunctionJob const&) = delete;
+	FunctionJob& operator=(FunctionJob const&) = delete;
+
+	template<typename Func>
+	void SetFunction(Func&& fn);
+	void ClearFunction();
+
+	void Execute() override;
+
+private:
+	alignas(std::max_align_t) unsigned char m_storage[JOB_FUNCTION_STORAGE_SIZE];
+	void (*m_invoke)(void* storage) = nullptr;
+	void (*m_destroy)(void* storage) = nullptr;
+
+	JobPool* m_pool = nullptr;
+	FunctionJob* m_nextFree = nullptr;
+};
+
+// Free list of FunctionJobs, grown a block at a time and never shrunk. Every worker has one and
+// non-worker threads share another, so threads do not fight over the heap to queue work.
+class JobPool
+{
+public:
+	JobPool() = default;
+	~JobPool();
+	JobPool(JobPool const&) = delete;
+	JobPool& operator=(JobPool const&) = delete;
+
+	FunctionJob* Acquire();
+	void Release(FunctionJob* job);
+
+private:
+	std::mutex m_mutex;		// only contended when a job is given back from another thread
+	FunctionJob* m_firstFree = nullptr;
+	std::vector<FunctionJob*> m_blocks;
+};
+
+//------------------------------------------------------------------------------------------------
+// Shared state of one ParallelFor. Every participant claims the next grain-sized chunk from
+// m_nextIndex until the range runs out, so uneven chunks balance themselves.
+struct ParallelForContext
+{
+	int m_begin = 0;
+	int m_end = 0;
+	int m_grain = 1;
+	std::atomic<int> m_nextIndex = 0;
+
+	void const* m_function = nullptr;
+	void (*m_runRange)(void const* function, int rangeBegin, int rangeEnd) = nullptr;
+
+	void RunChunks();
+};
+
+class ParallelForJob : public Job
+{
+public:
+	void Execute() override { m_context->RunChunks(); }
+
+	ParallelForContext* m_context = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------
+// Chase-Lev work-stealing deque. The owning worker pushes and pops at the bottom without locking;
+// any other thread may steal from the top. The ring grows on demand and old rings are kept until
+// the deque dies, since a thief may still be reading one.
+class WorkStealingDeque
+{
+public:
+	WorkStealingDeque(int64_t initialCapacity = 256);
+	~WorkStealingDeque();
+
+	void Push(Job* job);
+	Job* Pop();
+	Job* Steal();
+	size_t GetSize() const;
+
+private:
+	struct RingBuffer
+	{
+		RingBuffer(int64_t capacity);
+		~RingBuffer();
+
+		Job* Get(int64_t index) const { return m_slots[index & m_mask].load(std::memory_order_relaxed); }
+		void Put(int64_t index, Job* job) { m_slots[index & m_mask].store(job, std::memory_order_relaxed); }
+
+		int64_t m_capacity = 0;
+		int64_t m_mask = 0;
+		std::atomic<Job*>* m_slots = nullptr;
+	};
+
+	RingBuffer* Grow(RingBuffer* ring, int64_t top, int64_t bottom);
+
+	std::atomic<int64_t> m_top = 0;
+	std::atomic<int64_t> m_bottom = 0;
+	std::atomic<RingBuffer*> m_ring = nullptr;
+	std::vector<RingBuffer*> m_retiredRings;
+};
 
 class JobWorker
 {
@@ -41,6 +259,7 @@ class JobWorker
 	JobWorker(int id, JobSystem* system);
 	~JobWorker();
 
+	void Start();
 	void ThreadMain();
 
 private:
@@ -48,6 +267,32 @@ private:
 	std::atomic<unsigned int> m_jobTypeBitflags = 1;
 	JobSystem* m_system = nullptr;
 	std::thread* m_thread = nullptr;
+	int m_core = -1;						// logical core this worker is pinned to, -1 if it floats
+
+	// Only this worker pushes or pops its deques, one per priority. Jobs queued from other threads land
+	// in the inbox and are moved into the deques the next time this worker looks for work.
+	WorkStealingDeque m_deques[NUM_JOB_PRIORITIES];
+	std::deque<Job*> m_inbox;
+	std::mutex m_inboxMutex;
+	std::atomic<int> m_inboxSize = 0;		// lets claims skip the inbox lock when it is empty
+	int m_nextVictim = 0;
+	int m_spinLimit = JOB_WORKER_MIN_SPINS;
+
+	JobPool m_jobPool;
+	JobThreadCounters m_counters;
+};
+
+struct JobSystemBenchmarkResult
+{
+	double m_idleSeconds = 0.0;
+	double m_idleCPUSeconds = 0.0;		// process CPU time burned while nothing was queued
+	double m_idleCores = 0.0;			// m_idleCPUSeconds / m_idleSeconds
+
+	int m_numLatencySamples = 0;
+	double m_coldLatencyAvgMicroseconds = 0.0;	// queued after the workers had time to park
+	double m_coldLatencyMaxMicroseconds = 0.0;
+	double m_hotLatencyAvgMicroseconds = 0.0;	// queued back to back while workers are awake
+	double m_hotLatencyMaxMicroseconds = 0.0;
 };
 
 class JobSystem
@@ -68,22 +313,186 @@ public:
 	void DestroyWorkers();
 	size_t GetWorkersSize() const;
 	void QueueJob(Job* jobToQueue);
-	Job* ClaimJob(JobWorker* worker);
+	template<typename JobType>
+	void QueueJobs(JobType* const* jobs, size_t numJobs, JobCounter& counter);
+	Job* ClaimJob(JobWorker* worker, JobPriority lowestPriorityToRun = JobPriority::BACKGROUND);
 	void CompleteJob(Job* jobToComplete);
 	Job* RetrieveJob(Job* jobToRetrived = nullptr);
 	size_t GetNumQueuedJobs() const;
 	size_t GetNumCompletedJobs() const;
 
-	void ClearAllJobs();
+	// Counters since Startup, and the difference between the last two BeginFrame calls
+	JobSystemStats GetStats() const;
+	JobSystemStats const& GetFrameStats() const;
+
 	void SetWorkerThreadJobFlags(unsigned int bitflags, int num);
 
+	// Runs queued jobs on the calling thread until the counter reaches zero, so a job may wait on
+	// work it spawned without tying up the worker it runs on, and the main thread works instead of idling.
+	// Only jobs at lowestPriorityToRun or more urgent are picked up, so a frame never blocks on background work
+	void Wait(JobCounter const& counter, JobPriority lowestPriorityToRun = JobPriority::NORMAL);
+	bool RunOneJob(unsigned int bitflags = 1, JobPriority lowestPriorityToRun = JobPriority::BACKGROUND);
+
+	// fn(int index) for every index in [begin, end), split into chunks of grain indexes. A grain of 0 or
+	// less picks one from the range and the worker count. The calling thread works through chunks too
+	// and returns once all of them are done.
+	template<typename Func>
+	void ParallelFor(int begin, int end, int grain, Func const& fn);
+
+	// Folds map(index) over [begin, end) with reduce, which must be associative. Chunk results are
+	// combined in index order, so the result does not depend on which thread ran which chunk.
+	template<typename T, typename MapFunc, typename ReduceFunc>
+	T ParallelReduce(int begin, int end, int grain, T identity, MapFunc const& map, ReduceFunc const& reduce);
+
+	int GetParallelGrain(int count, int grain) const;
+
+	// A pooled job that runs fn(). Hand it back with ReleaseJob once it has completed; every job has to
+	// be released before Shutdown, which frees the pools.
+	template<typename Func>
+	FunctionJob* CreateJob(Func&& fn);
+	void ReleaseJob(FunctionJob* job);
+
 private:
+	JobPool& GetLocalJobPool();
+	JobThreadCounters& GetLocalCounters();
+	void ExecuteJob(Job* job, JobThreadCounters& counters);
+	void EnqueueReadyJob(Job* job);
+	JobWorker* FindWorkerForJob(Job* job);
+	void PostJobToWorker(Job* job);
+	void DrainInbox(JobWorker* worker);
+	Job* StealJob(JobWorker* thief, unsigned int bitflags, int priority);
+	Job* PopSharedQueue(unsigned int bitflags, int priority);
+	void RunParallelFor(ParallelForContext& context);
+	void ParkWorker(unsigned int wakeEpoch);
+	void WakeWorker();
+	void DrainCompletedJobs();
+	void UnlinkRetrievedJob(Job* job);
+
 	std::vector<JobWorker*> m_workers;
-	std::deque<Job*> m_queuedJobs;
-	std::deque<Job*> m_executingJobs;
-	std::deque<Job*> m_completedJobs;
+	// Jobs no worker's flags accept yet, split into one lane per distinct set of flags so a job nobody
+	// can run never sits in front of one somebody can
+	struct JobLane
+	{
+		unsigned int m_bitflags = 0;
+		std::deque<Job*> m_jobs;
+	};
+	std::vector<JobLane> m_sharedLanes[NUM_JOB_PRIORITIES];
+	std::atomic<size_t> m_numSharedJobs = 0;
 	mutable std::mutex m_queuedJobsMutex;
-	mutable std::mutex m_executingJobsMutex;
-	mutable std::mutex m_completedJobsMutex;
+	std::atomic<size_t> m_numQueuedJobs = 0;
+
+	// Finished jobs. Workers push onto m_completedStack without locking; retrieving threads move them,
+	// oldest first, into the retrieve list, where any one of them can be unlinked in constant time.
+	std::atomic<Job*> m_completedStack = nullptr;
+	Job* m_retrieveHead = nullptr;
+	Job* m_retrieveTail = nullptr;
+	std::mutex m_retrieveMutex;				// only between retrieving threads, workers never take it
+	std::atomic<size_t> m_numCompletedJobs = 0;
+	std::atomic<unsigned int> m_nextWorker = 0;
 	std::atomic<bool> m_isShuttingDown = false;
-};
\ No newline at end of file
+	JobPool m_externalJobPool;				// for threads that are not workers
+	JobThreadCounters m_helperCounters;		// likewise
+
+	double m_startTime = 0.0;
+	JobSystemStats m_frameStartStats;
+	JobSystemStats m_frameStats;
+
+	// Parked workers sleep until m_wakeEpoch moves past the value they saw before their last claim
+	std::mutex m_parkMutex;
+	std::condition_variable m_parkCondition;
+	std::atomic<unsigned int> m_wakeEpoch = 0;
+	std::atomic<int> m_numParkedWorkers = 0;
+
+	// Cores workers are pinned to in order of their ids, the reserved cores already taken off the front
+	std::vector<int> m_workerCores;
+};
+
+JobSystemBenchmarkResult RunJobSystemBenchmark(JobSystem* system, double idleSeconds = 1.0, int numLatencySamples = 200);
+
+//------------------------------------------------------------------------------------------------
+// The whole batch is counted before any of it is queued, so the counter cannot reach zero while
+// part of the batch is still being submitted
+template<typename JobType>
+void JobSystem::QueueJobs(JobType* const* jobs, size_t numJobs, JobCounter& counter)
+{
+	counter.m_count += (int)numJobs;
+	for (size_t i = 0; i < numJobs; i++)
+	{
+		jobs[i]->m_isRetrievable = false;
+		jobs[i]->m_completionCounter = &counter;
+		QueueJob(jobs[i]);
+	}
+}
+
+template<typename Func>
+void JobSystem::ParallelFor(int begin, int end, int grain, Func const& fn)
+{
+	if (end <= begin) return;
+
+	ParallelForContext context;
+	context.m_begin = begin;
+	context.m_end = end;
+	context.m_grain = GetParallelGrain(end - begin, grain);
+	context.m_nextIndex = begin;
+	context.m_function = &fn;
+	context.m_runRange = [](void const* function, int rangeBegin, int rangeEnd)
+	{
+		Func const& func = *static_cast<Func const*>(function);
+		for (int i = rangeBegin; i < rangeEnd; i++)
+		{
+			func(i);
+		}
+	};
+	RunParallelFor(context);
+}
+
+template<typename T, typename MapFunc, typename ReduceFunc>
+T JobSystem::ParallelReduce(int begin, int end, int grain, T identity, MapFunc const& map, ReduceFunc const& reduce)
+{
+	if (end <= begin) return identity;
+
+	int chunkSize = GetParallelGrain(end - begin, grain);
+	int numChunks = (end - begin + chunkSize - 1) / chunkSize;
+	std::vector<T> partials(numChunks, identity);
+
+	ParallelFor(0, numChunks, 1, [&](int chunk)
+	{
+		int chunkBegin = begin + chunk * chunkSize;
+		int chunkEnd = (end - chunkBegin < chunkSize) ? end : chunkBegin + chunkSize;
+		T partial = identity;
+		for (int i = chunkBegin; i < chunkEnd; i++)
+		{
+			partial = reduce(partial, map(i));
+		}
+		partials[chunk] = partial;
+	});
+
+	T result = identity;
+	for (T const& partial : partials)
+	{
+		result = reduce(result, partial);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------
+template<typename Func>
+void FunctionJob::SetFunction(Func&& fn)
+{
+	using Stored = std::decay_t<Func>;
+	static_assert(sizeof(Stored) <= JOB_FUNCTION_STORAGE_SIZE, "FunctionJob captures too large, capture a pointer to them instead");
+	static_assert(alignof(Stored) <= alignof(std::max_align_t), "FunctionJob captures are over-aligned");
+
+	ClearFunction();
+	new (m_storage) Stored(std::forward<Func>(fn));
+	m_invoke = [](void* storage) { (*static_cast<Stored*>(storage))(); };
+	m_destroy = [](void* storage) { static_cast<Stored*>(storage)->~Stored(); };
+}
+
+template<typename Func>
+FunctionJob* JobSystem::CreateJob(Func&& fn)
+{
+	FunctionJob* job = GetLocalJobPool().Acquire();
+	job->SetFunction(std::forward<Func>(fn));
+	return job;
+}
@@ -25,3 +25,28 @@ double GetCurrentTimeSeconds()
 	double currentSeconds = static_cast<double>(elapsedCountsSinceInitialTime) * secondsPerCount;
 	return currentSeconds;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// User plus kernel time consumed by every thread of this process
+double GetProcessCPUTimeSeconds()
+{
+	FILETIME creationTime;
+	FILETIME exitTime;
+	FILETIME kernelTime;
+	FILETIME userTime;
+	if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+	{
+		return 0.0;
+	}
+
+	ULARGE_INTEGER kernel;
+	kernel.LowPart = kernelTime.dwLowDateTime;
+	kernel.HighPart = kernelTime.dwHighDateTime;
+	ULARGE_INTEGER user;
+	user.LowPart = userTime.dwLowDateTime;
+	user.HighPart = userTime.dwHighDateTime;
+
+	// FILETIME counts 100ns ticks
+	return static_cast<double>(kernel.QuadPart + user.QuadPart) * 0.0000001;
+}
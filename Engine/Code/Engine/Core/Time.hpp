@@ -3,6 +3,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 //-----------------------------------------------------------------------------------------------
 double GetCurrentTimeSeconds();
+double GetProcessCPUTimeSeconds();
 //
 //double PCFreq = 0.0;
 //__int64 CounterStart = 0;
@@ -0,0 +1,48 @@
+#pragma once
+#include "Engine/Math/MathBuildPreferences.hpp"
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+#include "Engine/Math/DoubleVec3.hpp"
+#include "Engine/Math/DoubleQuaternion.hpp"
+#include <immintrin.h>
+
+// Only included by the math .cpp files. DoubleVec3 is {x, y, z, pad} and DoubleQuaternion is
+// {i, j, k, w}, both 32-byte aligned, so each loads as one register.
+
+inline __m256d LoadDoubleVec3(DoubleVec3 const& v)
+{
+	return _mm256_load_pd(&v.x);
+}
+
+// The pad lane is cleared in register, a scalar store after the vector one would stall the next load
+inline DoubleVec3 StoreDoubleVec3(__m256d lanes)
+{
+	DoubleVec3 result;
+	_mm256_store_pd(&result.x, _mm256_blend_pd(lanes, _mm256_setzero_pd(), 0x8));
+	return result;
+}
+
+inline void StoreDoubleVec3(DoubleVec3& out_v, __m256d lanes)
+{
+	_mm256_store_pd(&out_v.x, _mm256_blend_pd(lanes, _mm256_setzero_pd(), 0x8));
+}
+
+inline __m256d LoadDoubleQuaternion(DoubleQuaternion const& q)
+{
+	return _mm256_load_pd(&q.i);
+}
+
+inline DoubleQuaternion StoreDoubleQuaternion(__m256d lanes)
+{
+	DoubleQuaternion result;
+	_mm256_store_pd(&result.i, lanes);
+	return result;
+}
+
+// Flips the sign of the selected lanes; exact, so a + FlipSign(b) matches a - b bit for bit
+inline __m256d FlipSign(__m256d lanes, bool flip0, bool flip1, bool flip2, bool flip3)
+{
+	__m256d mask = _mm256_set_pd(flip3 ? -0.0 : 0.0, flip2 ? -0.0 : 0.0, flip1 ? -0.0 : 0.0, flip0 ? -0.0 : 0.0);
+	return _mm256_xor_pd(lanes, mask);
+}
+#endif
@@ -1,9 +1,8 @@
 #pragma once
-
+#include "Engine/Math/MathPrecision.hpp"
 
 //-----------------------------------------------------------------------------------------------
 struct DoubleVec2;
-struct DoubleVec3;
 
 struct DoubleVec4
 {
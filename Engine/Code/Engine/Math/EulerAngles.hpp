@@ -1,7 +1,5 @@
 #pragma once
-
-struct Mat44;
-struct Vec3;
+#include "Engine/Math/MathPrecision.hpp"
 
 struct EulerAngles
 {
@@ -0,0 +1,17 @@
+#pragma once
+//-----------------------------------------------------------------------------------------------
+// MathBuildPreferences.hpp
+//
+// Build switches for the math library. Kept apart from EngineBuildPreferences.hpp so the math
+// headers do not pull in renderer and platform includes.
+//
+
+//#define ENGINE_DOUBLE_MATH_AVX	// (If uncommented) TVec3<double>/TQuat<double> are 32-byte aligned and their hot operators use AVX.
+								// Results are bit-identical to the scalar build as long as /fp:fast and FMA contraction stay off.
+
+//#define ENGINE_EXACT_MATH		// (If uncommented) The Fast* functions in MathUtils.hpp, SinDegreesDouble/CosDegreesDouble, TQuat::SLerp,
+								// TQuat::ComputeQuaternion and the TVec3/TQuat Normalize calls use the exact library math again.
+
+#if defined(ENGINE_DOUBLE_MATH_AVX) && !defined(_WIN64) && !defined(__x86_64__)
+#error ENGINE_DOUBLE_MATH_AVX needs an x64 build: 32-byte aligned types cannot be passed by value on x86
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+#include "Engine/Math/MathBuildPreferences.hpp"
+#include <cstddef>
+
+//-----------------------------------------------------------------------------------------------
+// TVec3, TQuat and TMat44 are written once over their component type and instantiated for float
+// and double. The old type names stay as aliases, so include this instead of forward declaring them.
+template <typename T> struct TVec3;
+template <typename T> struct TQuat;
+template <typename T> struct TMat44;
+
+using Vec3 = TVec3<float>;
+using DoubleVec3 = TVec3<double>;
+using Quaternion = TQuat<float>;
+using DoubleQuaternion = TQuat<double>;
+using Mat44 = TMat44<float>;
+using DoubleMat44 = TMat44<double>;
+
+struct Vec2;
+struct Vec4;
+struct DoubleVec2;
+struct DoubleVec4;
+struct FloatRange;
+struct DoubleRange;
+
+//-----------------------------------------------------------------------------------------------
+// The types that are not templated yet, picked by precision
+template <typename T> struct MathPrecisionTypes;
+
+template <>
+struct MathPrecisionTypes<float>
+{
+	using OtherPrecision = double;
+	using Vec2Type = Vec2;
+	using Vec4Type = Vec4;
+	using RangeType = FloatRange;
+
+	static constexpr size_t SIMD_ALIGNMENT = alignof(float);
+};
+
+template <>
+struct MathPrecisionTypes<double>
+{
+	using OtherPrecision = float;
+	using Vec2Type = DoubleVec2;
+	using Vec4Type = DoubleVec4;
+	using RangeType = DoubleRange;
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+	static constexpr size_t SIMD_ALIGNMENT = 32;
+#else
+	static constexpr size_t SIMD_ALIGNMENT = alignof(double);
+#endif
+};
@@ -1,6 +1,12 @@
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/DoubleMathAVX.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/RaycastUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+#if defined(_M_X64) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
 
 
 
@@ -50,13 +56,59 @@ float Atan2Degrees(float y, float x)
 	return ConvertRadiansToDegrees(atan2f(y, x));
 }
 
+//..............................
+// Minimax-style polynomials for sin and cos over [-pi/4, pi/4], fitted at Chebyshev nodes in x^2
+static double SinKernelDouble(double r)
+{
+	double r2 = r * r;
+	return r + r * r2 * (-1.66666666638552893e-01 + r2 * (8.33333187471018330e-03 + r2 * (-1.98400867353779481e-04 + r2 * 2.72499258024867024e-06)));
+}
+
+static double CosKernelDouble(double r)
+{
+	double r2 = r * r;
+	return 1.0 + r2 * (-4.99999999691193106e-01 + r2 * (4.16666506445170282e-02 + r2 * (-1.38875891556004339e-03 + r2 * 2.44637882932532682e-05)));
+}
+
+// Truncation is one instruction where floor() may be a library call
+static int RoundToNearestIntDouble(double value)
+{
+	return (int)(value + (value < 0.0 ? -0.5 : 0.5));
+}
+
+// Picks the kernel for the quarter turn the angle was reduced from
+static double SinFromQuadrantDouble(int quadrant, double r)
+{
+	switch (quadrant & 3)
+	{
+	case 0:		return SinKernelDouble(r);
+	case 1:		return CosKernelDouble(r);
+	case 2:		return -SinKernelDouble(r);
+	default:	return -CosKernelDouble(r);
+	}
+}
+
+//..............................
 double CosDegreesDouble(double degrees)
 {
+#if defined(ENGINE_EXACT_MATH)
 	return cos(ConvertDegreesToRadiansDouble(degrees));
+#else
+	// Reducing by 90 degrees is exact, so no pi/2 split is needed here
+	if (fabs(degrees) > 1e9) return cos(ConvertDegreesToRadiansDouble(degrees));
+	int quadrant = RoundToNearestIntDouble(degrees * (1.0 / 90.0));
+	return SinFromQuadrantDouble(quadrant + 1, ConvertDegreesToRadiansDouble(degrees - (double)quadrant * 90.0));
+#endif
 }
 double SinDegreesDouble(double degrees)
 {
+#if defined(ENGINE_EXACT_MATH)
 	return sin(ConvertDegreesToRadiansDouble(degrees));
+#else
+	if (fabs(degrees) > 1e9) return sin(ConvertDegreesToRadiansDouble(degrees));
+	int quadrant = RoundToNearestIntDouble(degrees * (1.0 / 90.0));
+	return SinFromQuadrantDouble(quadrant, ConvertDegreesToRadiansDouble(degrees - (double)quadrant * 90.0));
+#endif
 }
 
 double Atan2DegreesDouble(double y, double x)
@@ -64,6 +116,90 @@ double Atan2DegreesDouble(double y, double x)
 	return ConvertRadiansToDegreesDouble(atan2(y, x));
 }
 
+//-----------------------------------------------------------------------------------------------
+//Fast Approximations
+
+constexpr double PI_OVER_TWO_HIGH = 1.57079632673412561417e+00;	// first 33 bits of pi/2, so quadrant * PI_OVER_TWO_HIGH is exact
+constexpr double PI_OVER_TWO_LOW = 6.07710050650619224932e-11;		// pi/2 - PI_OVER_TWO_HIGH
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+double FastSinRadiansDouble(double radians)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return sin(radians);
+#else
+	if (fabs(radians) > 1e5) return sin(radians);
+	int quadrant = RoundToNearestIntDouble(radians * TWO_OVER_PI);
+	double r = (radians - quadrant * PI_OVER_TWO_HIGH) - quadrant * PI_OVER_TWO_LOW;
+	return SinFromQuadrantDouble(quadrant, r);
+#endif
+}
+
+double FastCosRadiansDouble(double radians)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return cos(radians);
+#else
+	if (fabs(radians) > 1e5) return cos(radians);
+	int quadrant = RoundToNearestIntDouble(radians * TWO_OVER_PI);
+	double r = (radians - quadrant * PI_OVER_TWO_HIGH) - quadrant * PI_OVER_TWO_LOW;
+	return SinFromQuadrantDouble(quadrant + 1, r);
+#endif
+}
+
+// Abramowitz & Stegun 4.4.46: acos(x) = sqrt(1 - x) * p(x) on [0, 1], mirrored for negative x
+double FastAcosDouble(double cosine)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return acos(Clamp_Double(cosine, -1.0, 1.0));
+#else
+	double x = fabs(cosine);
+	if (x > 1.0) x = 1.0;
+	double p = 1.5707963050 + x * (-0.2145988016 + x * (0.0889789874 + x * (-0.0501743046 + x * (0.0308918810 + x * (-0.0170881256 + x * (0.0066700901 + x * -0.0012624911))))));
+	double angle = sqrt(1.0 - x) * p;
+	return cosine < 0.0 ? 3.14159265358979323846 - angle : angle;
+#endif
+}
+
+float FastSinRadians(float radians)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return sinf(radians);
+#else
+	return (float)FastSinRadiansDouble((double)radians);
+#endif
+}
+
+float FastCosRadians(float radians)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return cosf(radians);
+#else
+	return (float)FastCosRadiansDouble((double)radians);
+#endif
+}
+
+float FastAcos(float cosine)
+{
+#if defined(ENGINE_EXACT_MATH)
+	return acosf(Clamp(cosine, -1.f, 1.f));
+#else
+	return (float)FastAcosDouble((double)cosine);
+#endif
+}
+
+// The SSE estimate is good to 12 bits, one Newton step brings it close to float precision
+float FastInverseSqrt(float value)
+{
+#if defined(ENGINE_EXACT_MATH) || !(defined(_M_X64) || defined(__x86_64__))
+	return 1.f / sqrtf(value);
+#else
+	if (!(value >= FLT_MIN && value <= FLT_MAX)) return 1.f / sqrtf(value);
+	float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+	return estimate * (1.5f - 0.5f * value * estimate * estimate);
+#endif
+}
+
 //..............................
 float GetShortestAngularDispDegrees(float startDegrees, float endDegrees)
 {
@@ -2718,7 +2854,16 @@ float DotProduct3D(Vec3 const& a, Vec3 const& b)
 
 double DotProduct3D_Double(DoubleVec3 const& a, DoubleVec3 const& b)
 {
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+	// Products in parallel, then the same left-to-right sum as the scalar version
+	__m256d products = _mm256_mul_pd(LoadDoubleVec3(a), LoadDoubleVec3(b));
+	__m128d xy = _mm256_castpd256_pd128(products);
+	__m128d sum = _mm_add_sd(xy, _mm_unpackhi_pd(xy, xy));
+	sum = _mm_add_sd(sum, _mm256_extractf128_pd(products, 1));
+	return _mm_cvtsd_f64(sum);
+#else
 	return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+#endif
 }
 
 float DotProduct4D(Vec4 const& a, Vec4 const& b)
@@ -2752,11 +2897,17 @@ Vec3 CrossProduct3D(Vec3 A, Vec3 B)
 
 DoubleVec3 CrossProduct3D_Double(DoubleVec3 A, DoubleVec3 B)
 {
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+	__m256d left = _mm256_mul_pd(_mm256_set_pd(0.0, A.x, A.x, A.y), _mm256_set_pd(0.0, B.y, B.z, B.z));
+	__m256d right = _mm256_mul_pd(_mm256_set_pd(0.0, A.y, A.z, A.z), _mm256_set_pd(0.0, B.x, B.x, B.y));
+	return StoreDoubleVec3(FlipSign(_mm256_sub_pd(left, right), false, true, false, false));
+#else
 	DoubleVec3 result;
 	result.x = A.y * B.z - A.z * B.y;
 	result.y = -(A.x * B.z - A.z * B.x);
 	result.z = A.x * B.y - A.y * B.x;
 	return result;
+#endif
 }
 
 DoubleVec3 GetReflected3D_Double(DoubleVec3 orginal, DoubleVec3 normal)
@@ -2838,7 +2989,7 @@ DoubleQuaternion FindLookAtRotationQuaternionDouble(DoubleVec3 Start, DoubleVec3
 	rotationMatrix.SetIJK3D(forward, left, up);
 
 	// Convert rotation matrix to quaternion
-	return rotationMatrix.GetDoubleQuaternion();
+	return rotationMatrix.GetQuaternion();
 }
 
 EulerAngles FindLookAtRotationEulerAngle(Vec3 Start, Vec3 Target)
@@ -3345,3 +3496,482 @@ bool DoAABBOverlapConvexPoly2D(AABB2 box, ConvexPoly2 convex)
 	// No separating axis found = collision
 	return true; 
 }
+
+//-----------------------------------------------------------------------------------------------
+//Batched Narrowphase
+// Each kernel runs a branch-free pass over a block of pairs into stack scratch, selecting between
+// results instead of branching so the compiler can keep several pairs in one register, then writes
+// the block's CollisionInfos. The arithmetic mirrors the single-pair functions operation for operation.
+
+void DoubleVec3Array::Clear()
+{
+	x.clear();
+	y.clear();
+	z.clear();
+}
+
+void DoubleVec3Array::Reserve(size_t size)
+{
+	x.reserve(size);
+	y.reserve(size);
+	z.reserve(size);
+}
+
+void DoubleVec3Array::Add(DoubleVec3 const& v)
+{
+	x.push_back(v.x);
+	y.push_back(v.y);
+	z.push_back(v.z);
+}
+
+DoubleVec3 DoubleVec3Array::Get(size_t index) const
+{
+	return DoubleVec3(x[index], y[index], z[index]);
+}
+
+void SpherePairBatch::Clear()
+{
+	m_centersA.Clear();
+	m_radiiA.clear();
+	m_centersB.Clear();
+	m_radiiB.clear();
+}
+
+void SpherePairBatch::AddPair(DoubleVec3 const& centerA, double radiusA, DoubleVec3 const& centerB, double radiusB)
+{
+	m_centersA.Add(centerA);
+	m_radiiA.push_back(radiusA);
+	m_centersB.Add(centerB);
+	m_radiiB.push_back(radiusB);
+}
+
+size_t SpherePairBatch::GetNumPairs() const
+{
+	return m_radiiA.size();
+}
+
+void CapsuleSpherePairBatch::Clear()
+{
+	m_capsuleStarts.Clear();
+	m_capsuleEnds.Clear();
+	m_capsuleRadii.clear();
+	m_sphereCenters.Clear();
+	m_sphereRadii.clear();
+}
+
+void CapsuleSpherePairBatch::AddPair(DoubleCapsule3 const& capsule, DoubleVec3 const& center, double radius)
+{
+	m_capsuleStarts.Add(capsule.m_start);
+	m_capsuleEnds.Add(capsule.m_end);
+	m_capsuleRadii.push_back(capsule.m_radius);
+	m_sphereCenters.Add(center);
+	m_sphereRadii.push_back(radius);
+}
+
+size_t CapsuleSpherePairBatch::GetNumPairs() const
+{
+	return m_capsuleRadii.size();
+}
+
+void CapsulePairBatch::Clear()
+{
+	m_startsA.Clear();
+	m_endsA.Clear();
+	m_radiiA.clear();
+	m_startsB.Clear();
+	m_endsB.Clear();
+	m_radiiB.clear();
+}
+
+void CapsulePairBatch::AddPair(DoubleCapsule3 const& capsuleA, DoubleCapsule3 const& capsuleB)
+{
+	m_startsA.Add(capsuleA.m_start);
+	m_endsA.Add(capsuleA.m_end);
+	m_radiiA.push_back(capsuleA.m_radius);
+	m_startsB.Add(capsuleB.m_start);
+	m_endsB.Add(capsuleB.m_end);
+	m_radiiB.push_back(capsuleB.m_radius);
+}
+
+size_t CapsulePairBatch::GetNumPairs() const
+{
+	return m_radiiA.size();
+}
+
+void CapsuleOBBPairBatch::Clear()
+{
+	m_capsuleStarts.Clear();
+	m_capsuleEnds.Clear();
+	m_capsuleRadii.clear();
+	m_boxCenters.Clear();
+	m_boxIBasisNormals.Clear();
+	m_boxJBasisNormals.Clear();
+	m_boxHalfDimensions.Clear();
+}
+
+void CapsuleOBBPairBatch::AddPair(DoubleCapsule3 const& capsule, DoubleOBB3 const& box)
+{
+	m_capsuleStarts.Add(capsule.m_start);
+	m_capsuleEnds.Add(capsule.m_end);
+	m_capsuleRadii.push_back(capsule.m_radius);
+	m_boxCenters.Add(box.m_center);
+	m_boxIBasisNormals.Add(box.m_iBasisNormal);
+	m_boxJBasisNormals.Add(box.m_jBasisNormal);
+	m_boxHalfDimensions.Add(box.m_halfDimensions);
+}
+
+size_t CapsuleOBBPairBatch::GetNumPairs() const
+{
+	return m_capsuleRadii.size();
+}
+
+// Clamp_Double(value, 0, 1) as selects
+static inline double ClampZeroToOneSelect(double value)
+{
+	double result = value < 0.0 ? 0.0 : value;
+	return value > 1.0 ? 1.0 : result;
+}
+
+// DoubleVec3::GetNormalized's scale, zero for a zero length
+static inline double GetNormalizeScale(double length)
+{
+	return length <= 0.0 ? 0.0 : 1 / length;
+}
+
+//..............................
+void DoSpheresOverlap3D_Info(SpherePairBatch const& pairs, std::vector<CollisionInfo>& out_infos)
+{
+	size_t numPairs = pairs.GetNumPairs();
+	out_infos.resize(numPairs);
+
+	double const* ax = pairs.m_centersA.x.data();
+	double const* ay = pairs.m_centersA.y.data();
+	double const* az = pairs.m_centersA.z.data();
+	double const* ra = pairs.m_radiiA.data();
+	double const* bx = pairs.m_centersB.x.data();
+	double const* by = pairs.m_centersB.y.data();
+	double const* bz = pairs.m_centersB.z.data();
+	double const* rb = pairs.m_radiiB.data();
+
+	double contactX[NARROWPHASE_BATCH_BLOCK];
+	double contactY[NARROWPHASE_BATCH_BLOCK];
+	double contactZ[NARROWPHASE_BATCH_BLOCK];
+	bool isColliding[NARROWPHASE_BATCH_BLOCK];
+
+	for (size_t first = 0; first < numPairs; first += NARROWPHASE_BATCH_BLOCK)
+	{
+		size_t count = std::min(NARROWPHASE_BATCH_BLOCK, numPairs - first);
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = first + n;
+			double toBX = bx[i] - ax[i];
+			double toBY = by[i] - ay[i];
+			double toBZ = bz[i] - az[i];
+			double lengthSquared = (toBX * toBX) + (toBY * toBY) + (toBZ * toBZ);
+			double radiusSum = ra[i] + rb[i];
+			isColliding[n] = lengthSquared < radiusSum * radiusSum;
+
+			double length = sqrt(lengthSquared);
+			double offset = radiusSum - length;
+			double scale = GetNormalizeScale(length);
+			double distance = ra[i] - offset * 0.5;
+			contactX[n] = ax[i] + (length <= 0.0 ? 0.0 : toBX * scale) * distance;
+			contactY[n] = ay[i] + (length <= 0.0 ? 0.0 : toBY * scale) * distance;
+			contactZ[n] = az[i] + (length <= 0.0 ? 0.0 : toBZ * scale) * distance;
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			CollisionInfo& info = out_infos[first + n];
+			info = CollisionInfo();
+			if (isColliding[n])
+			{
+				info.isColliding = true;
+				info.contactPoint = DoubleVec3(contactX[n], contactY[n], contactZ[n]);
+			}
+		}
+	}
+}
+
+//..............................
+void DoCapsuleAndSphereOverlap3D_Info(CapsuleSpherePairBatch const& pairs, std::vector<CollisionInfo>& out_infos)
+{
+	size_t numPairs = pairs.GetNumPairs();
+	out_infos.resize(numPairs);
+
+	double const* sx = pairs.m_capsuleStarts.x.data();
+	double const* sy = pairs.m_capsuleStarts.y.data();
+	double const* sz = pairs.m_capsuleStarts.z.data();
+	double const* ex = pairs.m_capsuleEnds.x.data();
+	double const* ey = pairs.m_capsuleEnds.y.data();
+	double const* ez = pairs.m_capsuleEnds.z.data();
+	double const* capsuleRadii = pairs.m_capsuleRadii.data();
+	double const* cx = pairs.m_sphereCenters.x.data();
+	double const* cy = pairs.m_sphereCenters.y.data();
+	double const* cz = pairs.m_sphereCenters.z.data();
+	double const* sphereRadii = pairs.m_sphereRadii.data();
+
+	double contactX[NARROWPHASE_BATCH_BLOCK];
+	double contactY[NARROWPHASE_BATCH_BLOCK];
+	double contactZ[NARROWPHASE_BATCH_BLOCK];
+	double normalX[NARROWPHASE_BATCH_BLOCK];
+	double normalY[NARROWPHASE_BATCH_BLOCK];
+	double normalZ[NARROWPHASE_BATCH_BLOCK];
+	bool isColliding[NARROWPHASE_BATCH_BLOCK];
+
+	for (size_t first = 0; first < numPairs; first += NARROWPHASE_BATCH_BLOCK)
+	{
+		size_t count = std::min(NARROWPHASE_BATCH_BLOCK, numPairs - first);
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = first + n;
+
+			// GetNearestPointOnLineSegment3D_Double
+			double axisX = ex[i] - sx[i];
+			double axisY = ey[i] - sy[i];
+			double axisZ = ez[i] - sz[i];
+			double startToCenterX = cx[i] - sx[i];
+			double startToCenterY = cy[i] - sy[i];
+			double startToCenterZ = cz[i] - sz[i];
+			double t = ((startToCenterX * axisX) + (startToCenterY * axisY) + (startToCenterZ * axisZ)) / ((axisX * axisX) + (axisY * axisY) + (axisZ * axisZ));
+			t = ClampZeroToOneSelect(t);
+			double boneX = sx[i] + axisX * t;
+			double boneY = sy[i] + axisY * t;
+			double boneZ = sz[i] + axisZ * t;
+
+			double toBoneX = boneX - cx[i];
+			double toBoneY = boneY - cy[i];
+			double toBoneZ = boneZ - cz[i];
+			double distanceSquared = (toBoneX * toBoneX) + (toBoneY * toBoneY) + (toBoneZ * toBoneZ);
+			double radiusSum = capsuleRadii[i] + sphereRadii[i];
+			isColliding[n] = distanceSquared < radiusSum * radiusSum;
+
+			// GetNearestPointOnSphere3D_Double
+			double length = sqrt(distanceSquared);
+			double distance = length > sphereRadii[i] ? sphereRadii[i] : length;
+			double scale = GetNormalizeScale(length);
+			double pointX = cx[i] + (length <= 0.0 ? 0.0 : toBoneX * scale) * distance;
+			double pointY = cy[i] + (length <= 0.0 ? 0.0 : toBoneY * scale) * distance;
+			double pointZ = cz[i] + (length <= 0.0 ? 0.0 : toBoneZ * scale) * distance;
+			contactX[n] = pointX;
+			contactY[n] = pointY;
+			contactZ[n] = pointZ;
+
+			double fromCenterX = pointX - cx[i];
+			double fromCenterY = pointY - cy[i];
+			double fromCenterZ = pointZ - cz[i];
+			double normalLength = sqrt((fromCenterX * fromCenterX) + (fromCenterY * fromCenterY) + (fromCenterZ * fromCenterZ));
+			double normalScale = GetNormalizeScale(normalLength);
+			normalX[n] = normalLength <= 0.0 ? 0.0 : fromCenterX * normalScale;
+			normalY[n] = normalLength <= 0.0 ? 0.0 : fromCenterY * normalScale;
+			normalZ[n] = normalLength <= 0.0 ? 0.0 : fromCenterZ * normalScale;
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			CollisionInfo& info = out_infos[first + n];
+			info = CollisionInfo();
+			if (isColliding[n])
+			{
+				info.isColliding = true;
+				info.contactPoint = DoubleVec3(contactX[n], contactY[n], contactZ[n]);
+				info.normal = DoubleVec3(normalX[n], normalY[n], normalZ[n]);
+			}
+		}
+	}
+}
+
+//..............................
+void DoCapsulesOverlap3D_Info(CapsulePairBatch const& pairs, std::vector<CollisionInfo>& out_infos)
+{
+	size_t numPairs = pairs.GetNumPairs();
+	out_infos.resize(numPairs);
+
+	double const* sax = pairs.m_startsA.x.data();
+	double const* say = pairs.m_startsA.y.data();
+	double const* saz = pairs.m_startsA.z.data();
+	double const* eax = pairs.m_endsA.x.data();
+	double const* eay = pairs.m_endsA.y.data();
+	double const* eaz = pairs.m_endsA.z.data();
+	double const* ra = pairs.m_radiiA.data();
+	double const* sbx = pairs.m_startsB.x.data();
+	double const* sby = pairs.m_startsB.y.data();
+	double const* sbz = pairs.m_startsB.z.data();
+	double const* ebx = pairs.m_endsB.x.data();
+	double const* eby = pairs.m_endsB.y.data();
+	double const* ebz = pairs.m_endsB.z.data();
+	double const* rb = pairs.m_radiiB.data();
+
+	double contactX[NARROWPHASE_BATCH_BLOCK];
+	double contactY[NARROWPHASE_BATCH_BLOCK];
+	double contactZ[NARROWPHASE_BATCH_BLOCK];
+	double normalX[NARROWPHASE_BATCH_BLOCK];
+	double normalY[NARROWPHASE_BATCH_BLOCK];
+	double normalZ[NARROWPHASE_BATCH_BLOCK];
+	bool isColliding[NARROWPHASE_BATCH_BLOCK];
+
+	for (size_t first = 0; first < numPairs; first += NARROWPHASE_BATCH_BLOCK)
+	{
+		size_t count = std::min(NARROWPHASE_BATCH_BLOCK, numPairs - first);
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = first + n;
+
+			// Optimized_GetNearestPointsBetweenLines3D_Double, every branch evaluated and the taken one selected
+			double axisAX = eax[i] - sax[i];
+			double axisAY = eay[i] - say[i];
+			double axisAZ = eaz[i] - saz[i];
+			double axisBX = ebx[i] - sbx[i];
+			double axisBY = eby[i] - sby[i];
+			double axisBZ = ebz[i] - sbz[i];
+			double dotAxisAB = (axisAX * axisBX) + (axisAY * axisBY) + (axisAZ * axisBZ);
+			bool isParallel = dotAxisAB == 1 || dotAxisAB == -1;
+
+			double vX = sax[i] - sbx[i];
+			double vY = say[i] - sby[i];
+			double vZ = saz[i] - sbz[i];
+			double dA1 = (axisAX * axisAX) + (axisAY * axisAY) + (axisAZ * axisAZ);
+			double dA2 = (axisAX * vX) + (axisAY * vY) + (axisAZ * vZ);
+			double dB1 = (axisBX * axisBX) + (axisBY * axisBY) + (axisBZ * axisBZ);
+			double dB2 = (axisBX * vX) + (axisBY * vY) + (axisBZ * vZ);
+			double denom = dA1 * dB1 - dotAxisAB * dotAxisAB;
+
+			double tA = denom != 0 ? ClampZeroToOneSelect((dotAxisAB * dB2 - dA2 * dB1) / denom) : 0.0;
+			double tB = (dotAxisAB * tA + dB2) / dB1;
+			double tAFromStart = ClampZeroToOneSelect(-dA2 / dA1);
+			double tAFromEnd = ClampZeroToOneSelect((dotAxisAB - dA2) / dA1);
+			tA = tB < 0.0 ? tAFromStart : (tB > 1.0 ? tAFromEnd : tA);
+			tB = tB < 0.0 ? 0.0 : (tB > 1.0 ? 1.0 : tB);
+
+			double pointAX = isParallel ? sax[i] : sax[i] + axisAX * tA;
+			double pointAY = isParallel ? say[i] : say[i] + axisAY * tA;
+			double pointAZ = isParallel ? saz[i] : saz[i] + axisAZ * tA;
+			double pointBX = isParallel ? sbx[i] : sbx[i] + axisBX * tB;
+			double pointBY = isParallel ? sby[i] : sby[i] + axisBY * tB;
+			double pointBZ = isParallel ? sbz[i] : sbz[i] + axisBZ * tB;
+
+			double betweenX = pointAX - pointBX;
+			double betweenY = pointAY - pointBY;
+			double betweenZ = pointAZ - pointBZ;
+			double distanceSquared = (betweenX * betweenX) + (betweenY * betweenY) + (betweenZ * betweenZ);
+			double radiusSum = ra[i] + rb[i];
+			isColliding[n] = distanceSquared < radiusSum * radiusSum;
+
+			double distance = sqrt(distanceSquared);
+			double offset = ra[i] + rb[i] - distance;
+			double scale = GetNormalizeScale(distance);
+			double normalizedX = distance <= 0.0 ? 0.0 : betweenX * scale;
+			double normalizedY = distance <= 0.0 ? 0.0 : betweenY * scale;
+			double normalizedZ = distance <= 0.0 ? 0.0 : betweenZ * scale;
+			double alongNormal = rb[i] - offset * 0.5;
+			contactX[n] = pointBX + normalizedX * alongNormal;
+			contactY[n] = pointBY + normalizedY * alongNormal;
+			contactZ[n] = pointBZ + normalizedZ * alongNormal;
+			normalX[n] = normalizedX;
+			normalY[n] = normalizedY;
+			normalZ[n] = normalizedZ;
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			CollisionInfo& info = out_infos[first + n];
+			info = CollisionInfo();
+			if (isColliding[n])
+			{
+				info.isColliding = true;
+				info.contactPoint = DoubleVec3(contactX[n], contactY[n], contactZ[n]);
+				info.normal = DoubleVec3(normalX[n], normalY[n], normalZ[n]);
+			}
+		}
+	}
+}
+
+//..............................
+// The clipping against the local box branches too much to run wide, so only the moves into and out
+// of box space are batched. Those repeat DoubleMat44::GetOrthonormalInverse's products term by term,
+// zero terms included, so signed zeros come out as they do through the matrices.
+void DoCapsuleAndOBBOverlap3D_Info(CapsuleOBBPairBatch const& pairs, std::vector<CollisionInfo>& out_infos)
+{
+	size_t numPairs = pairs.GetNumPairs();
+	out_infos.resize(numPairs);
+
+	DoubleVec3Array const& starts = pairs.m_capsuleStarts;
+	DoubleVec3Array const& ends = pairs.m_capsuleEnds;
+	DoubleVec3Array const& centers = pairs.m_boxCenters;
+	DoubleVec3Array const& iBases = pairs.m_boxIBasisNormals;
+	DoubleVec3Array const& jBases = pairs.m_boxJBasisNormals;
+
+	double localStartX[NARROWPHASE_BATCH_BLOCK];
+	double localStartY[NARROWPHASE_BATCH_BLOCK];
+	double localStartZ[NARROWPHASE_BATCH_BLOCK];
+	double localEndX[NARROWPHASE_BATCH_BLOCK];
+	double localEndY[NARROWPHASE_BATCH_BLOCK];
+	double localEndZ[NARROWPHASE_BATCH_BLOCK];
+	double kBasisX[NARROWPHASE_BATCH_BLOCK];
+	double kBasisY[NARROWPHASE_BATCH_BLOCK];
+	double kBasisZ[NARROWPHASE_BATCH_BLOCK];
+
+	for (size_t first = 0; first < numPairs; first += NARROWPHASE_BATCH_BLOCK)
+	{
+		size_t count = std::min(NARROWPHASE_BATCH_BLOCK, numPairs - first);
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = first + n;
+			double ix = iBases.x[i], iy = iBases.y[i], iz = iBases.z[i];
+			double jx = jBases.x[i], jy = jBases.y[i], jz = jBases.z[i];
+			double kx = iy * jz - iz * jy;
+			double ky = -(ix * jz - iz * jx);
+			double kz = ix * jy - iy * jx;
+			kBasisX[n] = kx;
+			kBasisY[n] = ky;
+			kBasisZ[n] = kz;
+
+			// Rows of the inverse are the bases; the translation is each basis against the negated center
+			double tx = -1.0 * centers.x[i], ty = -1.0 * centers.y[i], tz = -1.0 * centers.z[i];
+			double rowXx = ((ix * 1.0 + iy * 0.0) + iz * 0.0) + 0.0 * 0.0;
+			double rowXy = ((ix * 0.0 + iy * 1.0) + iz * 0.0) + 0.0 * 0.0;
+			double rowXz = ((ix * 0.0 + iy * 0.0) + iz * 1.0) + 0.0 * 0.0;
+			double rowXt = ((ix * tx + iy * ty) + iz * tz) + 0.0 * 1.0;
+			double rowYx = ((jx * 1.0 + jy * 0.0) + jz * 0.0) + 0.0 * 0.0;
+			double rowYy = ((jx * 0.0 + jy * 1.0) + jz * 0.0) + 0.0 * 0.0;
+			double rowYz = ((jx * 0.0 + jy * 0.0) + jz * 1.0) + 0.0 * 0.0;
+			double rowYt = ((jx * tx + jy * ty) + jz * tz) + 0.0 * 1.0;
+			double rowZx = ((kx * 1.0 + ky * 0.0) + kz * 0.0) + 0.0 * 0.0;
+			double rowZy = ((kx * 0.0 + ky * 1.0) + kz * 0.0) + 0.0 * 0.0;
+			double rowZz = ((kx * 0.0 + ky * 0.0) + kz * 1.0) + 0.0 * 0.0;
+			double rowZt = ((kx * tx + ky * ty) + kz * tz) + 0.0 * 1.0;
+
+			double px = starts.x[i], py = starts.y[i], pz = starts.z[i];
+			localStartX[n] = (((rowXx * px) + (rowXy * py)) + (rowXz * pz)) + rowXt;
+			localStartY[n] = (((rowYx * px) + (rowYy * py)) + (rowYz * pz)) + rowYt;
+			localStartZ[n] = (((rowZx * px) + (rowZy * py)) + (rowZz * pz)) + rowZt;
+
+			px = ends.x[i], py = ends.y[i], pz = ends.z[i];
+			localEndX[n] = (((rowXx * px) + (rowXy * py)) + (rowXz * pz)) + rowXt;
+			localEndY[n] = (((rowYx * px) + (rowYy * py)) + (rowYz * pz)) + rowYt;
+			localEndZ[n] = (((rowZx * px) + (rowZy * py)) + (rowZz * pz)) + rowZt;
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = first + n;
+			DoubleVec3 halfDimensions = pairs.m_boxHalfDimensions.Get(i);
+			DoubleAABB3 aabb;
+			aabb.m_mins = DoubleVec3(-halfDimensions.x, -halfDimensions.y, -halfDimensions.z);
+			aabb.m_maxs = DoubleVec3(halfDimensions.x, halfDimensions.y, halfDimensions.z);
+
+			DoubleCapsule3 localCapsule;
+			localCapsule.m_radius = pairs.m_capsuleRadii[i];
+			localCapsule.m_start = DoubleVec3(localStartX[n], localStartY[n], localStartZ[n]);
+			localCapsule.m_end = DoubleVec3(localEndX[n], localEndY[n], localEndZ[n]);
+
+			CollisionInfo& info = out_infos[i];
+			info = DoCapsuleAndAABBOverlap3D_Info(localCapsule, aabb);
+
+			DoubleVec3 center = centers.Get(i);
+			DoubleVec3 local = info.contactPoint;
+			info.contactPoint = (iBases.Get(i) * local.x) + (jBases.Get(i) * local.y) + (DoubleVec3(kBasisX[n], kBasisY[n], kBasisZ[n]) * local.z) + center;
+			info.normal = (info.contactPoint - center).GetNormalized();
+		}
+	}
+}
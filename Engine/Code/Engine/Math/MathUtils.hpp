@@ -40,8 +40,6 @@
 
 // Forward Declaration and Const
 constexpr float PI = 3.14159265359f;
-struct Mat44;
-struct Quaternion;
 
 enum class BilboardType
 {
@@ -60,6 +58,75 @@ struct CollisionInfo
 	DoubleVec3 normal;
 };
 
+// Structure-of-arrays storage for the batched narrowphase: element i of every array belongs to pair i
+struct DoubleVec3Array
+{
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> z;
+
+	void Clear();
+	void Reserve(size_t size);
+	void Add(DoubleVec3 const& v);
+	DoubleVec3 Get(size_t index) const;
+};
+
+struct SpherePairBatch
+{
+	DoubleVec3Array m_centersA;
+	std::vector<double> m_radiiA;
+	DoubleVec3Array m_centersB;
+	std::vector<double> m_radiiB;
+
+	void Clear();
+	void AddPair(DoubleVec3 const& centerA, double radiusA, DoubleVec3 const& centerB, double radiusB);
+	size_t GetNumPairs() const;
+};
+
+struct CapsuleSpherePairBatch
+{
+	DoubleVec3Array m_capsuleStarts;
+	DoubleVec3Array m_capsuleEnds;
+	std::vector<double> m_capsuleRadii;
+	DoubleVec3Array m_sphereCenters;
+	std::vector<double> m_sphereRadii;
+
+	void Clear();
+	void AddPair(DoubleCapsule3 const& capsule, DoubleVec3 const& center, double radius);
+	size_t GetNumPairs() const;
+};
+
+struct CapsulePairBatch
+{
+	DoubleVec3Array m_startsA;
+	DoubleVec3Array m_endsA;
+	std::vector<double> m_radiiA;
+	DoubleVec3Array m_startsB;
+	DoubleVec3Array m_endsB;
+	std::vector<double> m_radiiB;
+
+	void Clear();
+	void AddPair(DoubleCapsule3 const& capsuleA, DoubleCapsule3 const& capsuleB);
+	size_t GetNumPairs() const;
+};
+
+struct CapsuleOBBPairBatch
+{
+	DoubleVec3Array m_capsuleStarts;
+	DoubleVec3Array m_capsuleEnds;
+	std::vector<double> m_capsuleRadii;
+	DoubleVec3Array m_boxCenters;
+	DoubleVec3Array m_boxIBasisNormals;
+	DoubleVec3Array m_boxJBasisNormals;
+	DoubleVec3Array m_boxHalfDimensions;
+
+	void Clear();
+	void AddPair(DoubleCapsule3 const& capsule, DoubleOBB3 const& box);
+	size_t GetNumPairs() const;
+};
+
+constexpr size_t NARROWPHASE_BATCH_BLOCK = 64;	// pairs computed into stack scratch before their CollisionInfos are written
+
 //Angle Utilities
 float ConvertDegreesToRadians(float degrees);
 float ConvertRadiansToDegrees(float radians);
@@ -73,6 +140,17 @@ double CosDegreesDouble(double degrees);
 double SinDegreesDouble(double degrees);
 double Atan2DegreesDouble(double y, double x);
 
+//Fast Approximations, for the solver's inner loops. Max errors were measured against long double over the whole input range.
+//SinDegreesDouble and CosDegreesDouble share the sin/cos polynomials, and the same 2e-10 bound.
+//Defining ENGINE_EXACT_MATH in MathBuildPreferences.hpp makes every one of them call the exact library function instead.
+double FastSinRadiansDouble(double radians);		// 2e-10 absolute; |radians| > 1e5 takes the exact path
+double FastCosRadiansDouble(double radians);		// 2e-10 absolute; |radians| > 1e5 takes the exact path
+double FastAcosDouble(double cosine);				// 2.2e-8 radians absolute over [-1, 1], input is clamped
+float FastSinRadians(float radians);				// the double approximation, rounded to float
+float FastCosRadians(float radians);				// the double approximation, rounded to float
+float FastAcos(float cosine);						// the double approximation, rounded to float
+float FastInverseSqrt(float value);					// 3e-7 relative; values outside the normal float range take the exact path
+
 float GetShortestAngularDispDegrees(float startDegrees, float endDegrees);
 float GetTurnedTowardDegrees(float currentDegrees, float goalDegrees, float maxDeltaDegrees);
 float GetAngleDegreesBetweenVectors2D(Vec2 const& a, Vec2 const& b);
@@ -159,6 +237,12 @@ CollisionInfo DoCapsuleAndSphereOverlap3D_Info(DoubleCapsule3 const& capsule, Do
 CollisionInfo DoCapsulesOverlap3D_Info(DoubleCapsule3 const& capsuleA, DoubleCapsule3 const& capsuleB);
 CollisionInfo DoSpheresOverlap3D_Info(DoubleVec3 const& centerA, double radiusA, DoubleVec3 const& centerB, double radiusB);
 
+// Batched variants: out_infos[i] matches the single-pair function on pair i bit for bit
+void DoCapsuleAndOBBOverlap3D_Info(CapsuleOBBPairBatch const& pairs, std::vector<CollisionInfo>& out_infos);
+void DoCapsuleAndSphereOverlap3D_Info(CapsuleSpherePairBatch const& pairs, std::vector<CollisionInfo>& out_infos);
+void DoCapsulesOverlap3D_Info(CapsulePairBatch const& pairs, std::vector<CollisionInfo>& out_infos);
+void DoSpheresOverlap3D_Info(SpherePairBatch const& pairs, std::vector<CollisionInfo>& out_infos);
+
 Vec2 GetNearestPointOnDisc2D(Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius);
 Vec2 GetNearestPointOnAABB2D(Vec2 const& referencePosition, AABB2 const& box);
 Vec2 GetNearestPointOnInfiniteLine2D(Vec2 const& referencePosition, LineSegment2 const& infiniteLine);
@@ -334,3 +418,44 @@ bool BounceCapsuleOffPlane3D_Double(DoubleCapsule3& capsule, DoubleVec3& startPo
 FloatRange ProjectVertices(std::vector<Vec2>& vertices, Vec2 axis);
 std::vector<Vec2> GetAxes(const std::vector<Vec2>& vertices);
 bool DoAABBOverlapConvexPoly2D(AABB2 box, ConvexPoly2 convex);
+
+// Precision dispatch, so code written once over TVec3<T>/TQuat<T>/TMat44<T> reaches the float or _Double function
+template <typename T> struct PrecisionMath;
+
+template <>
+struct PrecisionMath<float>
+{
+	static float ConvertDegreesToRadians(float degrees) { return ::ConvertDegreesToRadians(degrees); }
+	static float ConvertRadiansToDegrees(float radians) { return ::ConvertRadiansToDegrees(radians); }
+	static float CosDegrees(float degrees) { return ::CosDegrees(degrees); }
+	static float SinDegrees(float degrees) { return ::SinDegrees(degrees); }
+	static float Atan2Degrees(float y, float x) { return ::Atan2Degrees(y, x); }
+	static float FastSinRadians(float radians) { return ::FastSinRadians(radians); }
+	static float FastCosRadians(float radians) { return ::FastCosRadians(radians); }
+	static float FastAcos(float cosine) { return ::FastAcos(cosine); }
+	static float FastInverseSqrt(float value) { return ::FastInverseSqrt(value); }
+	static float Clamp(float value, float minValue, float maxValue) { return ::Clamp(value, minValue, maxValue); }
+	static bool Equal(float a, float compareTo, float tolerance) { return FloatEqual(a, compareTo, tolerance); }
+	static float DotProduct3D(Vec3 const& a, Vec3 const& b) { return ::DotProduct3D(a, b); }
+	static float DotProduct4D(Vec4 const& a, Vec4 const& b) { return ::DotProduct4D(a, b); }
+	static Vec3 CrossProduct3D(Vec3 const& a, Vec3 const& b) { return ::CrossProduct3D(a, b); }
+};
+
+template <>
+struct PrecisionMath<double>
+{
+	static double ConvertDegreesToRadians(double degrees) { return ConvertDegreesToRadiansDouble(degrees); }
+	static double ConvertRadiansToDegrees(double radians) { return ConvertRadiansToDegreesDouble(radians); }
+	static double CosDegrees(double degrees) { return CosDegreesDouble(degrees); }
+	static double SinDegrees(double degrees) { return SinDegreesDouble(degrees); }
+	static double Atan2Degrees(double y, double x) { return Atan2DegreesDouble(y, x); }
+	static double FastSinRadians(double radians) { return FastSinRadiansDouble(radians); }
+	static double FastCosRadians(double radians) { return FastCosRadiansDouble(radians); }
+	static double FastAcos(double cosine) { return FastAcosDouble(cosine); }
+	static double FastInverseSqrt(double value) { return 1.0 / sqrt(value); }	// rsqrt needs two Newton steps to reach double precision, which measured slower than this
+	static double Clamp(double value, double minValue, double maxValue) { return Clamp_Double(value, minValue, maxValue); }
+	static bool Equal(double a, double compareTo, double tolerance) { return DoubleEqual(a, compareTo, tolerance); }
+	static double DotProduct3D(DoubleVec3 const& a, DoubleVec3 const& b) { return DotProduct3D_Double(a, b); }
+	static double DotProduct4D(DoubleVec4 const& a, DoubleVec4 const& b) { return DotProduct4D_Double(a, b); }
+	static DoubleVec3 CrossProduct3D(DoubleVec3 const& a, DoubleVec3 const& b) { return CrossProduct3D_Double(a, b); }
+};
@@ -0,0 +1,948 @@
+#include "Engine/Math/TMat44.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/TQuat.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <cmath>
+
+template <typename T>
+TMat44<T> TMat44<T>::IDENTITY = TMat44<T>();
+
+template <typename T>
+TMat44<T>::TMat44()
+{
+	m_values[Ix] = 1;
+	m_values[Jx] = 0;
+	m_values[Kx] = 0;
+	m_values[Tx] = 0;
+
+	m_values[Iy] = 0;
+	m_values[Jy] = 1;
+	m_values[Ky] = 0;
+	m_values[Ty] = 0;
+
+	m_values[Iz] = 0;
+	m_values[Jz] = 0;
+	m_values[Kz] = 1;
+	m_values[Tz] = 0;
+
+	m_values[Iw] = 0;
+	m_values[Jw] = 0;
+	m_values[Kw] = 0;
+	m_values[Tw] = 1;
+
+}
+
+template <typename T>
+TMat44<T>::TMat44(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D, Vec2Type const& translation2D)
+{
+	m_values[Ix] = iBasis2D.x;
+	m_values[Jx] = jBasis2D.x;
+	m_values[Kx] = 0;
+	m_values[Tx] = translation2D.x;
+
+	m_values[Iy] = iBasis2D.y;
+	m_values[Jy] = jBasis2D.y;
+	m_values[Ky] = 0;
+	m_values[Ty] = translation2D.y;
+
+	m_values[Iz] = 0;
+	m_values[Jz] = 0;
+	m_values[Kz] = 1;
+	m_values[Tz] = 0;
+
+	m_values[Iw] = 0;
+	m_values[Jw] = 0;
+	m_values[Kw] = 0;
+	m_values[Tw] = 1;
+}
+
+template <typename T>
+TMat44<T>::TMat44(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D, TVec3<T> const& translation3D)
+{
+	m_values[Ix] = iBasis3D.x;
+	m_values[Jx] = jBasis3D.x;
+	m_values[Kx] = kBasis3D.x;
+	m_values[Tx] = translation3D.x;
+
+	m_values[Iy] = iBasis3D.y;
+	m_values[Jy] = jBasis3D.y;
+	m_values[Ky] = kBasis3D.y;
+	m_values[Ty] = translation3D.y;
+
+	m_values[Iz] = iBasis3D.z;
+	m_values[Jz] = jBasis3D.z;
+	m_values[Kz] = kBasis3D.z;
+	m_values[Tz] = translation3D.z;
+
+	m_values[Iw] = 0;
+	m_values[Jw] = 0;
+	m_values[Kw] = 0;
+	m_values[Tw] = 1;
+}
+
+template <typename T>
+TMat44<T>::TMat44(Vec4Type const& iBasis4D, Vec4Type const& jBasis4D, Vec4Type const& kBasis4D, Vec4Type const& translation4D)
+{
+	m_values[Ix] = iBasis4D.x;
+	m_values[Jx] = jBasis4D.x;
+	m_values[Kx] = kBasis4D.x;
+	m_values[Tx] = translation4D.x;
+
+	m_values[Iy] = iBasis4D.y;
+	m_values[Jy] = jBasis4D.y;
+	m_values[Ky] = kBasis4D.y;
+	m_values[Ty] = translation4D.y;
+
+	m_values[Iz] = iBasis4D.z;
+	m_values[Jz] = jBasis4D.z;
+	m_values[Kz] = kBasis4D.z;
+	m_values[Tz] = translation4D.z;
+
+	m_values[Iw] = iBasis4D.w;
+	m_values[Jw] = jBasis4D.w;
+	m_values[Kw] = kBasis4D.w;
+	m_values[Tw] = translation4D.w;
+}
+
+template <typename T>
+TMat44<T>::TMat44(T const* sixteenValuesBasisMajor)
+{
+	for (int i = 0; i < 16; i++)
+	{
+		m_values[i] = sixteenValuesBasisMajor[i];
+	}
+}
+
+template <typename T>
+TMat44<T>::TMat44(TMat44<OtherPrecision> mat)
+{
+	m_values[Ix] = static_cast<T>(mat.m_values[Ix]);
+	m_values[Jx] = static_cast<T>(mat.m_values[Jx]);
+	m_values[Kx] = static_cast<T>(mat.m_values[Kx]);
+	m_values[Tx] = static_cast<T>(mat.m_values[Tx]);
+	
+	m_values[Iy] = static_cast<T>(mat.m_values[Iy]);
+	m_values[Jy] = static_cast<T>(mat.m_values[Jy]);
+	m_values[Ky] = static_cast<T>(mat.m_values[Ky]);
+	m_values[Ty] = static_cast<T>(mat.m_values[Ty]);
+	
+	m_values[Iz] = static_cast<T>(mat.m_values[Iz]);
+	m_values[Jz] = static_cast<T>(mat.m_values[Jz]);
+	m_values[Kz] = static_cast<T>(mat.m_values[Kz]);
+	m_values[Tz] = static_cast<T>(mat.m_values[Tz]);
+	
+	m_values[Iw] = static_cast<T>(mat.m_values[Iw]);
+	m_values[Jw] = static_cast<T>(mat.m_values[Jw]);
+	m_values[Kw] = static_cast<T>(mat.m_values[Kw]);
+	m_values[Tw] = static_cast<T>(mat.m_values[Tw]);
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateTranslation2D(Vec2Type const& translationXY)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Tx] = translationXY.x;
+	mat.m_values[Ty] = translationXY.y;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateTranslation3D(TVec3<T> const& translationXYZ)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Tx] = translationXYZ.x;
+	mat.m_values[Ty] = translationXYZ.y;
+	mat.m_values[Tz] = translationXYZ.z;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateUniformScale2D(T uniformScaleXY)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = uniformScaleXY;
+	mat.m_values[Jy] = uniformScaleXY;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateUniformScale3D(T uniformScaleXYZ)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = uniformScaleXYZ;
+	mat.m_values[Jy] = uniformScaleXYZ;
+	mat.m_values[Kz] = uniformScaleXYZ;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateNonUniformScale2D(Vec2Type const& nonUniformScaleXY)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = nonUniformScaleXY.x;
+	mat.m_values[Jy] = nonUniformScaleXY.y;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateNonUniformScale3D(TVec3<T> const& nonUniformScaleXYZ)
+{
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = nonUniformScaleXYZ.x;
+	mat.m_values[Jy] = nonUniformScaleXYZ.y;
+	mat.m_values[Kz] = nonUniformScaleXYZ.z;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateZRotationDegrees(T rotationDegreesAboutZ)
+{
+	T cosAngle = PrecisionMath<T>::CosDegrees(rotationDegreesAboutZ);
+	T sinAngle = PrecisionMath<T>::SinDegrees(rotationDegreesAboutZ);
+
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = cosAngle;
+	mat.m_values[Iy] = sinAngle;
+	mat.m_values[Jx] = -sinAngle;
+	mat.m_values[Jy] = cosAngle;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateYRotationDegrees(T rotationDegreesAboutY)
+{
+	T cosAngle = PrecisionMath<T>::CosDegrees(rotationDegreesAboutY);
+	T sinAngle = PrecisionMath<T>::SinDegrees(rotationDegreesAboutY);
+
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Ix] = cosAngle;
+	mat.m_values[Iz] = -sinAngle;
+	mat.m_values[Kx] = sinAngle;
+	mat.m_values[Kz] = cosAngle;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateXRotationDegrees(T rotationDegreesAboutX)
+{
+	T cosAngle = PrecisionMath<T>::CosDegrees(rotationDegreesAboutX);
+	T sinAngle = PrecisionMath<T>::SinDegrees(rotationDegreesAboutX);
+
+	TMat44<T> mat = TMat44<T>();
+	mat.m_values[Jy] = cosAngle;
+	mat.m_values[Jz] = sinAngle;
+	mat.m_values[Ky] = -sinAngle;
+	mat.m_values[Kz] = cosAngle;
+	return mat;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateOrthoProjection(T left, T right, T bottom, T top, T zNear, T zFar)
+{
+	TMat44<T> ortho = TMat44<T>();
+	ortho.m_values[Ix] = 2.f / (right - left);
+	ortho.m_values[Jy] = 2.f / (top - bottom);
+	ortho.m_values[Kz] = 1.f / (zFar - zNear);
+	ortho.m_values[Tx] = (left + right) / (left - right);
+	ortho.m_values[Ty] = (bottom + top) / (bottom - top);
+	ortho.m_values[Tz] = zNear / (zNear - zFar);
+	return ortho;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreatePerspectiveProjection(T fovYDegrees, T aspect, T zNear, T zFar)
+{
+	TMat44<T> perspective = TMat44<T>();
+
+	T radFov = PrecisionMath<T>::ConvertDegreesToRadians(fovYDegrees);
+	T focalLength = 1.f / std::tan(radFov / 2.f);
+	T zRange = zFar - zNear;
+
+	perspective.m_values[Ix] = focalLength / aspect;
+	perspective.m_values[Jy] = focalLength;
+	perspective.m_values[Kz] = zFar / zRange;
+	perspective.m_values[Kw] = 1.f;
+
+	perspective.m_values[Tz] = -(zFar * zNear) / zRange;
+	perspective.m_values[Tw] = 0.f;
+
+	return perspective;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::CreateLookForward(TVec3<T> const& iBasis)
+{
+	TMat44<T> lookAt = TMat44<T>();
+
+	TVec3<T> kBasis;
+	TVec3<T> jBasis;
+
+	if (std::fabs(DotProduct3D(iBasis, TVec3<T>(0.f, 0.f, 1.f))) < 0.999f)
+	{
+		jBasis = CrossProduct3D(TVec3<T>(0.f, 0.f, 1.f), iBasis).GetNormalized();
+		kBasis = CrossProduct3D(iBasis, jBasis);
+	}
+	else
+	{
+		kBasis = CrossProduct3D(iBasis, TVec3<T>(0.f, 1.f, 0.f)).GetNormalized();
+		jBasis = CrossProduct3D(kBasis, iBasis);
+	}
+	lookAt.SetIJK3D(iBasis, jBasis, kBasis);
+
+	return lookAt;
+}
+
+template <typename T>
+TMat44<T> const TMat44<T>::TransformWorldToLocal(TMat44<T> const& worldMat)
+{
+	TMat44<T> localMat = worldMat;
+	localMat.GetOrthonormalInverse();
+	return localMat;
+}
+
+template <typename T>
+typename TMat44<T>::Vec2Type const TMat44<T>::TransformVectorQuantity2D(Vec2Type const& vectorQuantityXY) const
+{
+	return (GetIBasis2D() * vectorQuantityXY.x) + (GetJBasis2D() * vectorQuantityXY.y);
+}
+
+template <typename T>
+TVec3<T> const TMat44<T>::TransformVectorQuantity3D(TVec3<T> const& vectorQuantityXYZ) const
+{
+	return (GetIBasis3D() * vectorQuantityXYZ.x) + (GetJBasis3D() * vectorQuantityXYZ.y) + (GetKBasis3D() * vectorQuantityXYZ.z);
+}
+
+template <typename T>
+typename TMat44<T>::Vec2Type const TMat44<T>::TransformPosition2D(Vec2Type const& positionXY) const
+{
+	return (GetIBasis2D() * positionXY.x) + (GetJBasis2D() * positionXY.y) + GetTranslation2D();
+}
+
+template <typename T>
+TVec3<T> const TMat44<T>::TransformPosition3D(TVec3<T> const& positionXYZ) const
+{
+	return (GetIBasis3D() * positionXYZ.x) + (GetJBasis3D() * positionXYZ.y) + (GetKBasis3D() * positionXYZ.z) + GetTranslation3D();
+}
+
+template <typename T>
+typename TMat44<T>::Vec4Type const TMat44<T>::TransformHomogeneous3D(Vec4Type const& homogeneousPoint3D) const
+{
+	return (GetIBasis4D() * homogeneousPoint3D.x) + (GetJBasis4D() * homogeneousPoint3D.y) + (GetKBasis4D() * homogeneousPoint3D.z) + (GetTranslation4D() * homogeneousPoint3D.w);
+}
+
+template <typename T>
+T* TMat44<T>::GetAsArray()
+{
+	return m_values;
+}
+
+template <typename T>
+T const* TMat44<T>::GetAsArray() const
+{
+	return m_values;
+}
+
+template <typename T>
+typename TMat44<T>::Vec2Type TMat44<T>::GetIBasis2D() const
+{
+	return Vec2Type(m_values[Ix], m_values[Iy]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec2Type TMat44<T>::GetJBasis2D() const
+{
+	return Vec2Type(m_values[Jx], m_values[Jy]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec2Type TMat44<T>::GetTranslation2D() const
+{
+	return Vec2Type(m_values[Tx], m_values[Ty]);
+}
+
+template <typename T>
+TVec3<T> TMat44<T>::GetIBasis3D() const
+{
+	return TVec3<T>(m_values[Ix], m_values[Iy], m_values[Iz]);
+}
+
+template <typename T>
+TVec3<T> TMat44<T>::GetJBasis3D() const
+{
+	return TVec3<T>(m_values[Jx], m_values[Jy], m_values[Jz]);
+}
+
+template <typename T>
+TVec3<T> TMat44<T>::GetKBasis3D() const
+{
+	return TVec3<T>(m_values[Kx], m_values[Ky], m_values[Kz]);
+}
+
+template <typename T>
+TVec3<T> TMat44<T>::GetTranslation3D() const
+{
+	return TVec3<T>(m_values[Tx], m_values[Ty], m_values[Tz]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec4Type TMat44<T>::GetIBasis4D() const
+{
+	return Vec4Type(m_values[Ix], m_values[Iy], m_values[Iz], m_values[Iw]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec4Type TMat44<T>::GetJBasis4D() const
+{
+	return Vec4Type(m_values[Jx], m_values[Jy], m_values[Jz], m_values[Jw]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec4Type TMat44<T>::GetKBasis4D() const
+{
+	return Vec4Type(m_values[Kx], m_values[Ky], m_values[Kz], m_values[Kw]);
+}
+
+template <typename T>
+typename TMat44<T>::Vec4Type TMat44<T>::GetTranslation4D() const
+{
+	return Vec4Type(m_values[Tx], m_values[Ty], m_values[Tz], m_values[Tw]);
+}
+
+template <typename T>
+TMat44<T> TMat44<T>::GetOrthonormalInverse() const
+{
+	TMat44<T> antiRotation;
+	antiRotation.SetIJK3D(GetIBasis3D(), GetJBasis3D(), GetKBasis3D());
+	antiRotation.Transpose();
+
+	TMat44<T> antiTranslation;
+	antiTranslation.SetTranslation3D(-1.f * GetTranslation3D());
+
+	TMat44<T> result = antiRotation;
+	result.Append(antiTranslation);
+
+	return result;
+}
+
+template <typename T>
+TMat44<T> TMat44<T>::GetLookAtTarget(TVec3<T> const& targetPosition) const
+{
+	TMat44<T> result;
+
+	TVec3<T> axis = targetPosition - GetTranslation3D();
+	TVec3<T> iBasis = axis.GetNormalized();
+	TVec3<T> kBasis;
+	TVec3<T> jBasis;
+
+	if (std::fabs(DotProduct3D(iBasis, TVec3<T>(0.f, 0.f, 1.f))) < 0.9999f)
+	{
+		jBasis = CrossProduct3D(TVec3<T>(0.f, 0.f, 1.f), iBasis).GetNormalized();
+		kBasis = CrossProduct3D(iBasis, jBasis);
+	}
+	else
+	{
+		kBasis = CrossProduct3D(iBasis, TVec3<T>(0.f, 1.f, 0.f)).GetNormalized();
+		jBasis = CrossProduct3D(kBasis, iBasis);
+	}
+
+	result.SetIJK3D(iBasis, jBasis, kBasis);
+	return result;
+}
+
+template <typename T>
+EulerAngles TMat44<T>::GetEulerAngle() const
+{
+	EulerAngles result;
+	if (m_values[Kz] < 1)
+	{
+		if (m_values[Kz] > -1)
+		{
+			result.m_pitchDegrees = static_cast<float>(std::asin(m_values[Kz]));
+			result.m_yawDegrees = static_cast<float>(std::atan2(-m_values[Jz], m_values[Iz]));
+			result.m_rollDegrees = static_cast<float>(std::atan2(-m_values[Ky], m_values[Kx]));
+		}
+		else
+		{
+			result.m_pitchDegrees = -PI / 2;
+			result.m_yawDegrees = -static_cast<float>(std::atan2(m_values[Jy], m_values[Jx]));
+			result.m_rollDegrees = 0.f;
+		}
+	}
+	else
+	{
+		result.m_pitchDegrees = PI / 2;
+		result.m_yawDegrees = static_cast<float>(std::atan2(m_values[Jy], m_values[Jx]));
+		result.m_rollDegrees = 0.f;
+	}
+
+	result.m_pitchDegrees = ConvertRadiansToDegrees(result.m_pitchDegrees);
+	result.m_yawDegrees = ConvertRadiansToDegrees(result.m_yawDegrees);
+	result.m_rollDegrees = ConvertRadiansToDegrees(result.m_rollDegrees);
+
+	return result;
+}
+
+template <typename T>
+TQuat<T> TMat44<T>::GetQuaternion() const
+{
+	return TQuat<T>(*this);
+}
+
+template <typename T>
+TMat44<T> TMat44<T>::GetInverseRotationMatrix() const
+{
+	TMat44<T> result;
+	// Copy the 3x3 rotation part in transposed order
+	result.m_values[Ix] = m_values[Ix];
+	result.m_values[Iy] = m_values[Jx];
+	result.m_values[Iz] = m_values[Kx];
+
+	result.m_values[Jx] = m_values[Iy];
+	result.m_values[Jy] = m_values[Jy];
+	result.m_values[Jz] = m_values[Ky];
+
+	result.m_values[Kx] = m_values[Iz];
+	result.m_values[Ky] = m_values[Jz];
+	result.m_values[Kz] = m_values[Kz];
+
+	// Set translation to zero
+	result.m_values[Tx] = 0.0f;
+	result.m_values[Ty] = 0.0f;
+	result.m_values[Tz] = 0.0f;
+	result.m_values[Tw] = 1.0f;
+
+	return result;
+}
+
+template <typename T>
+void TMat44<T>::LookAtTarget(TVec3<T> const& targetPosition)
+{
+	TVec3<T> axis = targetPosition - GetTranslation3D();
+	TVec3<T> iBasis = axis.GetNormalized();
+	TVec3<T> kBasis;
+	TVec3<T> jBasis;
+
+	if (std::fabs(DotProduct3D(iBasis, TVec3<T>(0.f, 0.f, 1.f))) < 0.9999f)
+	{
+		jBasis = CrossProduct3D(TVec3<T>(0.f, 0.f, 1.f), iBasis).GetNormalized();
+		kBasis = CrossProduct3D(iBasis, jBasis);
+	}
+	else
+	{
+		kBasis = CrossProduct3D(iBasis, TVec3<T>(0.f, 1.f, 0.f)).GetNormalized();
+		jBasis = CrossProduct3D(kBasis, iBasis);
+	}
+	SetIJK3D(iBasis, jBasis, kBasis);
+}
+
+template <typename T>
+void TMat44<T>::LookAtTargetXY(TVec3<T> const& targetPosition)
+{
+	TVec3<T> axis = targetPosition - GetTranslation3D();
+	TVec3<T> iBasis = axis.GetNormalized();
+	TVec3<T> kBasis;
+	TVec3<T> jBasis;
+
+	if (std::fabs(DotProduct3D(iBasis, TVec3<T>(0.f, 0.f, 1.f))) != 1.f)
+	{
+		jBasis = CrossProduct3D(TVec3<T>(0.f, 0.f, 1.f), iBasis).GetNormalized();
+		kBasis = CrossProduct3D(iBasis, jBasis);
+	}
+	else
+	{
+		kBasis = CrossProduct3D(iBasis, TVec3<T>(0.f, 1.f, 0.f)).GetNormalized();
+		jBasis = CrossProduct3D(kBasis, iBasis);
+	}
+	SetIJK3D(iBasis, jBasis, TVec3<T>(0.f, 0.f, 1.f));
+}
+
+template <typename T>
+void TMat44<T>::SetTranslation2D(Vec2Type const& translationXY)
+{
+	m_values[Tx] = translationXY.x;
+	m_values[Ty] = translationXY.y;
+	m_values[Tz] = 0;
+	m_values[Tw] = 1;
+}
+
+template <typename T>
+void TMat44<T>::SetTranslation3D(TVec3<T> const& translationXYZ)
+{
+	m_values[Tx] = translationXYZ.x;
+	m_values[Ty] = translationXYZ.y;
+	m_values[Tz] = translationXYZ.z;
+	m_values[Tw] = 1;
+}
+
+template <typename T>
+void TMat44<T>::SetQuaternion(TQuat<T> q)
+{
+	*this = q.GetMatrix(this->GetTranslation3D());
+}
+
+template <typename T>
+void TMat44<T>::SetEulerAngle(EulerAngles a)
+{
+	T Cy = PrecisionMath<T>::CosDegrees(a.m_yawDegrees);
+	T Sy = PrecisionMath<T>::SinDegrees(a.m_yawDegrees);
+	T Cp = PrecisionMath<T>::CosDegrees(a.m_pitchDegrees);
+	T Sp = PrecisionMath<T>::SinDegrees(a.m_pitchDegrees);
+	T Cr = PrecisionMath<T>::CosDegrees(a.m_rollDegrees);
+	T Sr = PrecisionMath<T>::SinDegrees(a.m_rollDegrees);
+
+	TVec3<T> forwardIBasis = TVec3<T>(Cy * Cp, Cp * Sy, -Sp);
+	TVec3<T> leftJBasis = TVec3<T>(Sr * Sp * Cy - Sy * Cr, Sr * Sp * Sy + Cr * Cy, Sr * Cp);
+	TVec3<T> upKBasis = TVec3<T>(Sp * Cr * Cy + Sy * Sr, Sp * Cr * Sy - Sr * Cy, Cp * Cr);
+
+	SetIJK3D(forwardIBasis, leftJBasis, upKBasis);
+}
+
+template <typename T>
+void TMat44<T>::SetIJ2D(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D)
+{
+	m_values[Ix] = iBasis2D.x;
+	m_values[Iy] = iBasis2D.y;
+	m_values[Iz] = 0;
+	m_values[Iw] = 0;
+
+	m_values[Jx] = jBasis2D.x;
+	m_values[Jy] = jBasis2D.y;
+	m_values[Jz] = 0;
+	m_values[Jw] = 0;
+}
+
+template <typename T>
+void TMat44<T>::SetIJT2D(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D, Vec2Type const& translationXY)
+{
+	SetIJ2D(iBasis2D, jBasis2D);
+	SetTranslation2D(translationXY);
+}
+
+template <typename T>
+void TMat44<T>::SetIJK3D(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D)
+{
+	m_values[Ix] = iBasis3D.x;
+	m_values[Iy] = iBasis3D.y;
+	m_values[Iz] = iBasis3D.z;
+	m_values[Iw] = 0;
+
+	m_values[Jx] = jBasis3D.x;
+	m_values[Jy] = jBasis3D.y;
+	m_values[Jz] = jBasis3D.z;
+	m_values[Jw] = 0;
+
+	m_values[Kx] = kBasis3D.x;
+	m_values[Ky] = kBasis3D.y;
+	m_values[Kz] = kBasis3D.z;
+	m_values[Kw] = 0;
+}
+
+template <typename T>
+void TMat44<T>::SetIJKT3D(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D, TVec3<T> const& translationXYZ)
+{
+	SetIJK3D(iBasis3D, jBasis3D, kBasis3D);
+	SetTranslation3D(translationXYZ);
+}
+
+template <typename T>
+void TMat44<T>::SetIJKT4D(Vec4Type const& iBasis4D, Vec4Type const& jBasis4D, Vec4Type const& kBasis4D, Vec4Type const& translation4D)
+{
+	m_values[Ix] = iBasis4D.x;
+	m_values[Jx] = jBasis4D.x;
+	m_values[Kx] = kBasis4D.x;
+	m_values[Tx] = translation4D.x;
+
+	m_values[Iy] = iBasis4D.y;
+	m_values[Jy] = jBasis4D.y;
+	m_values[Ky] = kBasis4D.y;
+	m_values[Ty] = translation4D.y;
+
+	m_values[Iz] = iBasis4D.z;
+	m_values[Jz] = jBasis4D.z;
+	m_values[Kz] = kBasis4D.z;
+	m_values[Tz] = translation4D.z;
+
+	m_values[Iw] = iBasis4D.w;
+	m_values[Jw] = jBasis4D.w;
+	m_values[Kw] = kBasis4D.w;
+	m_values[Tw] = translation4D.w;
+}
+
+
+template <typename T>
+void TMat44<T>::Transpose()
+{
+	Vec4Type Itransposed(m_values[Ix], m_values[Jx], m_values[Kx], m_values[Tx]);
+	Vec4Type Jtransposed(m_values[Iy], m_values[Jy], m_values[Ky], m_values[Ty]);
+	Vec4Type Ktransposed(m_values[Iz], m_values[Jz], m_values[Kz], m_values[Tz]);
+	Vec4Type Ttransposed(m_values[Iw], m_values[Jw], m_values[Kw], m_values[Tw]);
+
+	SetIJKT4D(Itransposed, Jtransposed, Ktransposed, Ttransposed);
+}
+
+template <typename T>
+void TMat44<T>::Orthonormalize_IFwd_JLeft_KUp()
+{
+	//GramSchmidt process
+
+	TVec3<T> iBasis = GetIBasis3D();
+	TVec3<T> jBasis = GetJBasis3D();
+	TVec3<T> kBasis = GetKBasis3D();
+
+	T dot = DotProduct3D(iBasis, kBasis);
+	iBasis -= dot * kBasis;
+	iBasis.Normalize();
+
+	T handedness =
+		(iBasis.x * (kBasis.y * kBasis.z - kBasis.z * kBasis.y) +
+			iBasis.y * (kBasis.z * kBasis.x - kBasis.x * kBasis.z) +
+			iBasis.z * (kBasis.x * kBasis.y - kBasis.y * kBasis.x)) < 0.0f ? -1.0f : 1.0f;
+
+	iBasis.z = handedness;
+	jBasis = CrossProduct3D(kBasis, iBasis);
+
+	SetIJK3D(iBasis, jBasis, kBasis);
+}
+
+template <typename T>
+void TMat44<T>::Append(TMat44<T> const& appendThis)
+{
+	Vec4Type LeftX = Vec4Type(m_values[Ix], m_values[Jx], m_values[Kx], m_values[Tx]);
+	Vec4Type LeftY = Vec4Type(m_values[Iy], m_values[Jy], m_values[Ky], m_values[Ty]);
+	Vec4Type LeftZ = Vec4Type(m_values[Iz], m_values[Jz], m_values[Kz], m_values[Tz]);
+	Vec4Type LeftW = Vec4Type(m_values[Iw], m_values[Jw], m_values[Kw], m_values[Tw]);
+
+	Vec4Type RightI = Vec4Type(appendThis.m_values[Ix], appendThis.m_values[Iy], appendThis.m_values[Iz], appendThis.m_values[Iw]);
+	Vec4Type RightJ = Vec4Type(appendThis.m_values[Jx], appendThis.m_values[Jy], appendThis.m_values[Jz], appendThis.m_values[Jw]);
+	Vec4Type RightK = Vec4Type(appendThis.m_values[Kx], appendThis.m_values[Ky], appendThis.m_values[Kz], appendThis.m_values[Kw]);
+	Vec4Type RightT = Vec4Type(appendThis.m_values[Tx], appendThis.m_values[Ty], appendThis.m_values[Tz], appendThis.m_values[Tw]);
+
+	m_values[Ix] = PrecisionMath<T>::DotProduct4D(LeftX, RightI);
+	m_values[Iy] = PrecisionMath<T>::DotProduct4D(LeftY, RightI);
+	m_values[Iz] = PrecisionMath<T>::DotProduct4D(LeftZ, RightI);
+	m_values[Iw] = PrecisionMath<T>::DotProduct4D(LeftW, RightI);
+
+	m_values[Jx] = PrecisionMath<T>::DotProduct4D(LeftX, RightJ);
+	m_values[Jy] = PrecisionMath<T>::DotProduct4D(LeftY, RightJ);
+	m_values[Jz] = PrecisionMath<T>::DotProduct4D(LeftZ, RightJ);
+	m_values[Jw] = PrecisionMath<T>::DotProduct4D(LeftW, RightJ);
+
+	m_values[Kx] = PrecisionMath<T>::DotProduct4D(LeftX, RightK);
+	m_values[Ky] = PrecisionMath<T>::DotProduct4D(LeftY, RightK);
+	m_values[Kz] = PrecisionMath<T>::DotProduct4D(LeftZ, RightK);
+	m_values[Kw] = PrecisionMath<T>::DotProduct4D(LeftW, RightK);
+
+	m_values[Tx] = PrecisionMath<T>::DotProduct4D(LeftX, RightT);
+	m_values[Ty] = PrecisionMath<T>::DotProduct4D(LeftY, RightT);
+	m_values[Tz] = PrecisionMath<T>::DotProduct4D(LeftZ, RightT);
+	m_values[Tw] = PrecisionMath<T>::DotProduct4D(LeftW, RightT);
+}
+
+template <typename T>
+void TMat44<T>::AppendQuaternion(TQuat<T> const& quaternion)
+{
+	TQuat<T> q = quaternion;
+	// Normalize the quaternion to ensure it represents a valid rotation
+	q.Normalize();
+
+	// Convert quaternion to rotation matrix
+	T xx = q.i * q.i;
+	T xy = q.i * q.j;
+	T xz = q.i * q.k;
+	T xw = q.i * q.w;
+	T yy = q.j * q.j;
+	T yz = q.j * q.k;
+	T yw = q.j * q.w;
+	T zz = q.k * q.k;
+	T zw = q.k * q.w;
+
+	TMat44<T> rotationMatrix;
+	rotationMatrix.m_values[Ix] = 1 - 2 * (yy + zz);
+	rotationMatrix.m_values[Iy] = 2 * (xy - zw);
+	rotationMatrix.m_values[Iz] = 2 * (xz + yw);
+	rotationMatrix.m_values[Iw] = 0.0f;
+
+	rotationMatrix.m_values[Jx] = 2 * (xy + zw);
+	rotationMatrix.m_values[Jy] = 1 - 2 * (xx + zz);
+	rotationMatrix.m_values[Jz] = 2 * (yz - xw);
+	rotationMatrix.m_values[Jw] = 0.0f;
+
+	rotationMatrix.m_values[Kx] = 2 * (xz - yw);
+	rotationMatrix.m_values[Ky] = 2 * (yz + xw);
+	rotationMatrix.m_values[Kz] = 1 - 2 * (xx + yy);
+	rotationMatrix.m_values[Kw] = 0.0f;
+
+	rotationMatrix.m_values[Tx] = 0.0f;
+	rotationMatrix.m_values[Ty] = 0.0f;
+	rotationMatrix.m_values[Tz] = 0.0f;
+	rotationMatrix.m_values[Tw] = 1.0f;
+
+	// Append the rotation matrix to the current matrix
+	Append(rotationMatrix);
+}
+
+template <typename T>
+void TMat44<T>::RotateToQuaternion(TQuat<T> q)
+{
+	// Normalize the quaternion to ensure it represents a valid rotation
+	q.Normalize();
+
+	// Convert quaternion to rotation matrix
+	T ii = q.i * q.i;
+	T ij = q.i * q.j;
+	T ik = q.i * q.k;
+	T iw = q.i * q.w;
+	T jj = q.j * q.j;
+	T jk = q.j * q.k;
+	T jw = q.j * q.w;
+	T kk = q.k * q.k;
+	T kw = q.k * q.w;
+
+	// Set the rotation part of the matrix
+	m_values[Ix] = 1 - 2 * (jj + kk);
+	m_values[Iy] = 2 * (ij - kw);
+	m_values[Iz] = 2 * (ik + jw);
+
+	m_values[Jx] = 2 * (ij + kw);
+	m_values[Jy] = 1 - 2 * (ii + kk);
+	m_values[Jz] = 2 * (jk - iw);
+
+	m_values[Kx] = 2 * (ik - jw);
+	m_values[Ky] = 2 * (jk + iw);
+	m_values[Kz] = 1 - 2 * (ii + jj);
+
+	// Ensure the last row remains [0, 0, 0, 1]
+	m_values[Iw] = 0.0f;
+	m_values[Jw] = 0.0f;
+	m_values[Kw] = 0.0f;
+	m_values[Tw] = 1.0f;
+}
+
+template <typename T>
+void TMat44<T>::AppendRotationAxis(T degreesRotation, const TVec3<T>& rotationAxis)
+{
+	T radians = PrecisionMath<T>::ConvertDegreesToRadians(degreesRotation);
+	TVec3<T> axis = rotationAxis.GetNormalized();
+	T c = std::cos(radians);
+	T s = std::sin(radians);
+	T t = 1.0f - c;
+
+	T x = axis.x, y = axis.y, z = axis.z;
+
+	TMat44<T> rotationMatrix;
+	rotationMatrix.m_values[Ix] = t * x * x + c;
+	rotationMatrix.m_values[Iy] = t * x * y - s * z;
+	rotationMatrix.m_values[Iz] = t * x * z + s * y;
+	rotationMatrix.m_values[Iw] = 0.0f;
+
+	rotationMatrix.m_values[Jx] = t * x * y + s * z;
+	rotationMatrix.m_values[Jy] = t * y * y + c;
+	rotationMatrix.m_values[Jz] = t * y * z - s * x;
+	rotationMatrix.m_values[Jw] = 0.0f;
+
+	rotationMatrix.m_values[Kx] = t * x * z - s * y;
+	rotationMatrix.m_values[Ky] = t * y * z + s * x;
+	rotationMatrix.m_values[Kz] = t * z * z + c;
+	rotationMatrix.m_values[Kw] = 0.0f;
+
+	rotationMatrix.m_values[Tx] = 0.0f;
+	rotationMatrix.m_values[Ty] = 0.0f;
+	rotationMatrix.m_values[Tz] = 0.0f;
+	rotationMatrix.m_values[Tw] = 1.0f;
+
+	Append(rotationMatrix);
+}
+
+template <typename T>
+void TMat44<T>::AppendZRotation(T degreesRotationAboutZ)
+{
+	TMat44<T> mat = TMat44<T>::CreateZRotationDegrees(degreesRotationAboutZ);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendYRotation(T degreesRotationAboutY)
+{
+	TMat44<T> mat = TMat44<T>::CreateYRotationDegrees(degreesRotationAboutY);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendXRotation(T degreesRotationAboutX)
+{
+	TMat44<T> mat = TMat44<T>::CreateXRotationDegrees(degreesRotationAboutX);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendTranslation2D(Vec2Type const& translationXY)
+{
+	TMat44<T> mat = TMat44<T>::CreateTranslation2D(translationXY);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendTranslation3D(TVec3<T> const& translationXYZ)
+{
+	TMat44<T> mat = TMat44<T>::CreateTranslation3D(translationXYZ);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendScaleUniform2D(T uniformScaleXY)
+{
+	TMat44<T> mat = TMat44<T>::CreateUniformScale2D(uniformScaleXY);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendScaleUniform3D(T uniformScaleXYZ)
+{
+	TMat44<T> mat = TMat44<T>::CreateUniformScale3D(uniformScaleXYZ);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendScaleNonUniform2D(Vec2Type const& nonUniformScaleXY)
+{
+	TMat44<T> mat = TMat44<T>::CreateNonUniformScale2D(nonUniformScaleXY);
+	Append(mat);
+}
+
+template <typename T>
+void TMat44<T>::AppendScaleNonUniform3D(TVec3<T> const& nonUniformScaleXYZ)
+{
+	TMat44<T> mat = TMat44<T>::CreateNonUniformScale3D(nonUniformScaleXYZ);
+	Append(mat);
+}
+
+template <typename T>
+bool TMat44<T>::operator!=(const TMat44<T>& compare) const
+{
+	return !(*this == compare);
+}
+
+template <typename T>
+bool TMat44<T>::operator==(const TMat44<T>& compare) const
+{
+	return
+		m_values[Ix] == compare.m_values[Ix]
+		&& m_values[Jx] == compare.m_values[Jx]
+		&& m_values[Kx] == compare.m_values[Kx]
+		&& m_values[Tx] == compare.m_values[Tx]
+		&& m_values[Iy] == compare.m_values[Iy]
+		&& m_values[Jy] == compare.m_values[Jy]
+		&& m_values[Ky] == compare.m_values[Ky]
+		&& m_values[Ty] == compare.m_values[Ty]
+		&& m_values[Iz] == compare.m_values[Iz]
+		&& m_values[Jz] == compare.m_values[Jz]
+		&& m_values[Kz] == compare.m_values[Kz]
+		&& m_values[Tz] == compare.m_values[Tz]
+		&& m_values[Iw] == compare.m_values[Iw]
+		&& m_values[Jw] == compare.m_values[Jw]
+		&& m_values[Kw] == compare.m_values[Kw]
+		&& m_values[Tw] == compare.m_values[Tw];
+}
+
+template struct TMat44<float>;
+template struct TMat44<double>;
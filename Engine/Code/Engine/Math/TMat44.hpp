@@ -0,0 +1,108 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/DoubleVec2.hpp"
+#include "Engine/Math/DoubleVec4.hpp"
+#include "Engine/Math/TVec3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+template <typename T>
+struct TMat44
+{
+	enum
+	{
+		Ix, Iy, Iz, Iw,
+		Jx, Jy, Jz, Jw,
+		Kx, Ky, Kz, Kw,
+		Tx, Ty, Tz, Tw
+	};
+
+	using Vec2Type = typename MathPrecisionTypes<T>::Vec2Type;
+	using Vec4Type = typename MathPrecisionTypes<T>::Vec4Type;
+	using OtherPrecision = typename MathPrecisionTypes<T>::OtherPrecision;
+
+	T m_values[16];
+
+	TMat44();
+	TMat44(TMat44<OtherPrecision> mat);
+
+	static TMat44 IDENTITY;
+
+	explicit TMat44(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D, Vec2Type const& translation2D = Vec2Type());
+	explicit TMat44(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D, TVec3<T> const& translation3D = TVec3<T>());
+	explicit TMat44(Vec4Type const& iBasis4D, Vec4Type const& jBasis4D, Vec4Type const& kBasis4D, Vec4Type const& translation4D);
+	explicit TMat44(T const* sixteenValuesBasisMajor);
+
+	static TMat44 const CreateTranslation2D(Vec2Type const& translationXY);
+	static TMat44 const CreateTranslation3D(TVec3<T> const& translationXYZ);
+	static TMat44 const CreateUniformScale2D(T uniformScaleXY);
+	static TMat44 const CreateUniformScale3D(T uniformScaleXYZ);
+	static TMat44 const CreateNonUniformScale2D(Vec2Type const& nonUniformScaleXY);
+	static TMat44 const CreateNonUniformScale3D(TVec3<T> const& nonUniformScaleXYZ);
+	static TMat44 const CreateZRotationDegrees(T rotationDegreesAboutZ);
+	static TMat44 const CreateYRotationDegrees(T rotationDegreesAboutY);
+	static TMat44 const CreateXRotationDegrees(T rotationDegreesAboutX);
+	static TMat44 const CreateOrthoProjection(T left, T right, T bottom, T top, T zNear, T zFar);
+	static TMat44 const CreatePerspectiveProjection(T fovYDegrees, T aspect, T zNear, T zFar);
+	static TMat44 const CreateLookForward(TVec3<T> const& iBasis);
+	static TMat44 const TransformWorldToLocal(TMat44 const& worldMat);
+
+	Vec2Type const	TransformVectorQuantity2D(Vec2Type const& vectorQuantityXY) const;
+	TVec3<T> const	TransformVectorQuantity3D(TVec3<T> const& vectorQuantityXYZ) const;
+	Vec2Type const	TransformPosition2D(Vec2Type const& positionXY) const;
+	TVec3<T> const	TransformPosition3D(TVec3<T> const& positionXYZ) const;
+	Vec4Type const	TransformHomogeneous3D(Vec4Type const& homogeneousPoint3D) const;
+
+	T*				GetAsArray();
+	T const*		GetAsArray() const;
+	Vec2Type		GetIBasis2D() const;
+	Vec2Type		GetJBasis2D() const;
+	Vec2Type		GetTranslation2D() const;
+	TVec3<T>		GetIBasis3D() const;
+	TVec3<T>		GetJBasis3D() const;
+	TVec3<T>		GetKBasis3D() const;
+	TVec3<T>		GetTranslation3D() const;
+	Vec4Type		GetIBasis4D() const;
+	Vec4Type		GetJBasis4D() const;
+	Vec4Type		GetKBasis4D() const;
+	Vec4Type		GetTranslation4D() const;
+	TMat44			GetOrthonormalInverse() const;
+	TMat44			GetLookAtTarget(TVec3<T> const& targetPosition) const;
+	EulerAngles		GetEulerAngle() const;
+	TQuat<T>		GetQuaternion() const;
+	TMat44			GetInverseRotationMatrix() const;
+
+	void LookAtTarget(TVec3<T> const& targetPosition);
+	void LookAtTargetXY(TVec3<T> const& targetPosition);
+	void SetTranslation2D(Vec2Type const& translationXY);
+	void SetTranslation3D(TVec3<T> const& translationXYZ);
+	void SetQuaternion(TQuat<T> q);
+	void SetEulerAngle(EulerAngles q);
+	void SetIJ2D(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D);
+	void SetIJT2D(Vec2Type const& iBasis2D, Vec2Type const& jBasis2D, Vec2Type const& translationXY);
+	void SetIJK3D(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D);
+	void SetIJKT3D(TVec3<T> const& iBasis3D, TVec3<T> const& jBasis3D, TVec3<T> const& kBasis3D, TVec3<T> const& translationXYZ);
+	void SetIJKT4D(Vec4Type const& iBasis4D, Vec4Type const& jBasis4D, Vec4Type const& kBasis4D, Vec4Type const& translation4D);
+	void Transpose();
+	void Orthonormalize_IFwd_JLeft_KUp();
+
+	void Append(TMat44 const& appendThis);
+	void AppendQuaternion(TQuat<T> const& q);
+	void RotateToQuaternion(TQuat<T> q);
+	void AppendRotationAxis(T degreesRotation, const TVec3<T>& rotationAxis);
+	void AppendZRotation(T degreesRotationAboutZ);
+	void AppendYRotation(T degreesRotationAboutY);
+	void AppendXRotation(T degreesRotationAboutX);
+	void AppendTranslation2D(Vec2Type const& translationXY);
+	void AppendTranslation3D(TVec3<T> const& translationXYZ);
+	void AppendScaleUniform2D(T uniformScaleXY);
+	void AppendScaleUniform3D(T uniformScaleXYZ);
+	void AppendScaleNonUniform2D(Vec2Type const& nonUniformScaleXY);
+	void AppendScaleNonUniform3D(TVec3<T> const& nonUniformScaleXYZ);
+
+	bool		operator==(const TMat44& compare) const;
+	bool		operator!=(const TMat44& compare) const;
+};
+
+extern template struct TMat44<float>;
+extern template struct TMat44<double>;
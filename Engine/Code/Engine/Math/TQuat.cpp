@@ -0,0 +1,602 @@
+#include "Engine/Math/TQuat.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/DoubleMathAVX.hpp"
+#include <cmath>
+
+template <typename T>
+TQuat<T>::TQuat(T i, T j, T k)
+	:i(i), j(j), k(k)
+{
+
+}
+
+template <typename T>
+TQuat<T>::TQuat(T i, T j, T k, T w)
+	:i(i), j(j), k(k), w(w)
+{
+
+}
+
+template <typename T>
+TQuat<T>::TQuat(EulerAngles const& eulerAngle)
+{
+	T angle;
+
+	angle = eulerAngle.m_rollDegrees * 0.5f;
+	const T sr = PrecisionMath<T>::SinDegrees(angle);
+	const T cr = PrecisionMath<T>::CosDegrees(angle);
+
+	angle = eulerAngle.m_pitchDegrees * 0.5f;
+	const T sp = PrecisionMath<T>::SinDegrees(angle);
+	const T cp = PrecisionMath<T>::CosDegrees(angle);
+
+	angle = eulerAngle.m_yawDegrees * 0.5f;
+	const T sy = PrecisionMath<T>::SinDegrees(angle);
+	const T cy = PrecisionMath<T>::CosDegrees(angle);
+
+	const T cpcy = cp * cy;
+	const T spcy = sp * cy;
+	const T cpsy = cp * sy;
+	const T spsy = sp * sy;
+
+	i = (sr * cpcy - cr * spsy);
+	j = (cr * spcy + sr * cpsy);
+	k = (cr * cpsy - sr * spcy);
+	w = (cr * cpcy + sr * spsy);
+
+	Normalize();
+}
+
+template <typename T>
+TQuat<T>::TQuat(TMat44<T> const& mat)
+{
+	const T diag = mat.m_values[mat.Ix] + mat.m_values[mat.Jy] + mat.m_values[mat.Kz] + 1;
+
+	if (diag > 0.0f)
+	{
+		const T scale = std::sqrt(diag) * 2.0f; // get scale from diagonal
+
+		i = (mat.m_values[mat.Jz] - mat.m_values[mat.Ky]) / scale;
+		j = (mat.m_values[mat.Kx] - mat.m_values[mat.Iz]) / scale;
+		k = (mat.m_values[mat.Iy] - mat.m_values[mat.Jx]) / scale;
+		w = 0.25f * scale;
+	}
+	else
+	{
+		if (mat.m_values[mat.Ix] > mat.m_values[mat.Jy] && mat.m_values[mat.Ix] > mat.m_values[mat.Kz])
+		{
+			// 1st element of diag is greatest value
+			// find scale according to 1st element, and double it
+			const T scale = std::sqrt(1.0f + mat.m_values[mat.Ix] - mat.m_values[mat.Jy] - mat.m_values[mat.Kz]) * 2.0f;
+			i = 0.25f * scale;
+			j = (mat.m_values[mat.Jx] + mat.m_values[mat.Iy]) / scale;
+			k = (mat.m_values[mat.Iz] + mat.m_values[mat.Kx]) / scale;
+			w = (mat.m_values[mat.Jz] - mat.m_values[mat.Ky]) / scale;
+		}
+		else if (mat.m_values[mat.Jy] > mat.m_values[mat.Kz])
+		{
+			// 2nd element of diag is greatest value
+			// find scale according to 2nd element, and double it
+			const T scale = std::sqrt(1.0f + mat.m_values[mat.Jy] - mat.m_values[mat.Ix] - mat.m_values[mat.Kz]) * 2.0f;
+			i = (mat.m_values[mat.Jx] + mat.m_values[mat.Iy]) / scale;
+			j = 0.25f * scale;
+			k = (mat.m_values[mat.Ky] + mat.m_values[mat.Jz]) / scale;
+			w = (mat.m_values[mat.Kx] - mat.m_values[mat.Iz]) / scale;
+		}
+		else
+		{
+			// 3rd element of diag is greatest value
+			// find scale according to 3rd element, and double it
+			const T scale = std::sqrt(1.0f + mat.m_values[mat.Kz] - mat.m_values[mat.Ix] - mat.m_values[mat.Jy]) * 2.0f;
+			i = (mat.m_values[mat.Kx] + mat.m_values[mat.Iz]) / scale;
+			j = (mat.m_values[mat.Ky] + mat.m_values[mat.Jz]) / scale;
+			k = 0.25f * scale;
+			w = (mat.m_values[mat.Iy] - mat.m_values[mat.Jx]) / scale;
+		}
+
+	}
+	Normalize();
+}
+
+template <typename T>
+TQuat<T>::TQuat(TQuat<T> const& copyFrom)
+	:i(copyFrom.i), j(copyFrom.j), k(copyFrom.k), w(copyFrom.w)
+{
+
+}
+
+template <typename T>
+TQuat<T>::TQuat(TVec3<T> const& rotationVec)
+	:i(rotationVec.x), j(rotationVec.y), k(rotationVec.z), w(0)
+{
+
+}
+
+template <typename T>
+TQuat<T>::TQuat(T angle, TVec3<T> const& axis)
+{
+	T halfAngle = angle / 2;
+	T cosAngle = std::cos(halfAngle);
+	T sinAngle = std::sin(halfAngle);
+
+	w = cosAngle;
+	i = sinAngle * axis.x;
+	j = sinAngle * axis.y;
+	k = sinAngle * axis.z;
+}
+
+template <typename T>
+TQuat<T>::TQuat(TQuat<OtherPrecision> q)
+{
+	i = static_cast<T>(q.i);
+	j = static_cast<T>(q.j);
+	k = static_cast<T>(q.k);
+	w = static_cast<T>(q.w);
+}
+
+template <typename T>
+TMat44<T> TQuat<T>::GetMatrix(TVec3<T> translation) const
+{
+	TMat44<T> result;
+
+	result.m_values[result.Ix] = 1.0f - 2.0f * j * j - 2.0f * k * k;
+	result.m_values[result.Iy] = 2.0f * i * j + 2.0f * k * w;
+	result.m_values[result.Iz] = 2.0f * i * k - 2.0f * j * w;
+	result.m_values[result.Iw] = 0.0f;
+
+	result.m_values[result.Jx] = 2.0f * i * j - 2.0f * k * w;
+	result.m_values[result.Jy] = 1.0f - 2.0f * i * i - 2.0f * k * k;
+	result.m_values[result.Jz] = 2.0f * k * j + 2.0f * i * w;
+	result.m_values[result.Jw] = 0.0f;
+
+	result.m_values[result.Kx] = 2.0f * i * k + 2.0f * j * w;
+	result.m_values[result.Ky] = 2.0f * k * j - 2.0f * i * w;
+	result.m_values[result.Kz] = 1.0f - 2.0f * i * i - 2.0f * j * j;
+	result.m_values[result.Kw] = 0.0f;
+
+	result.m_values[result.Tx] = translation.x;
+	result.m_values[result.Ty] = translation.y;
+	result.m_values[result.Tz] = translation.z;
+	result.m_values[result.Tw] = 1.f;
+
+	return result;
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::GetNormalized() const
+{
+	const T n = i * i + j * j + k * k + w * w;
+
+	if (n == 1.f)
+	{
+		return *this;
+	}
+
+	T oneOverSqrt = PrecisionMath<T>::FastInverseSqrt(n);
+	return { i * oneOverSqrt, j * oneOverSqrt, k * oneOverSqrt, w * oneOverSqrt };
+}
+
+template <typename T>
+void TQuat<T>::Normalize()
+{
+	const T n = i * i + j * j + k * k + w * w;
+
+	if (n != 1.f)
+	{
+		T oneOverSqrt = PrecisionMath<T>::FastInverseSqrt(n);
+		*this = (TQuat<T>(i * oneOverSqrt, j * oneOverSqrt, k * oneOverSqrt, w * oneOverSqrt));
+	}
+}
+
+template <typename T>
+EulerAngles TQuat<T>::ToEuler()
+{
+	EulerAngles euler;
+
+	const T wSq = w * w;
+	const T iSq = i * i;
+	const T jSq = j * j;
+	const T kSq = k * k;
+	const T test = 2.0f * (j * w - i * k);
+
+	if (PrecisionMath<T>::Equal(test, 1.0f, 0.000001f))
+	{
+		// heading = rotation about z-axis
+		euler.m_yawDegrees = (float)(-2.0 * std::atan2(i, w));
+		// bank = rotation about x-axis
+		euler.m_rollDegrees = 0;
+		// attitude = rotation about y-axis
+		euler.m_pitchDegrees = (float)(PI / 2.0);
+	}
+	else if (PrecisionMath<T>::Equal(test, -1.0f, 0.000001f))
+	{
+		// heading = rotation about z-axis
+		euler.m_yawDegrees = (float)(2.0 * std::atan2(i, w));
+		// bank = rotation about x-axis
+		euler.m_rollDegrees = 0;
+		// attitude = rotation about y-axis
+		euler.m_pitchDegrees = (float)(PI / -2.0);
+	}
+	else
+	{
+		// heading = rotation about z-axis
+		euler.m_yawDegrees = (float)std::atan2(2.0 * (i * j + k * w), (iSq - jSq - kSq + wSq));
+		// bank = rotation about x-axis
+		euler.m_rollDegrees = (float)std::atan2(2.0 * (j * k + i * w), (-iSq - jSq + kSq + wSq));
+		// attitude = rotation about y-axis
+		euler.m_pitchDegrees = (float)std::asin(PrecisionMath<T>::Clamp(test, -1.0, 1.0));
+	}
+
+	return euler;
+}
+
+template <typename T>
+void TQuat<T>::ToAngleAxis(T& angleRadian, TVec3<T>& axis) const
+{
+	const T scale = std::sqrt(i * i + j * j + k * k);
+
+	if (PrecisionMath<T>::Equal(scale, 0.f, 0.0000001f) || w > 1.0f || w < -1.0f)
+	{
+		angleRadian = 0.0f;
+		axis.x = 0.0f;
+		axis.y = 1.0f;
+		axis.z = 0.0f;
+	}
+	else
+	{
+		const T invscale = 1.f / scale;
+		angleRadian = 2.0f * std::acos(w);
+		axis.x = i * invscale;
+		axis.y = j * invscale;
+		axis.z = k * invscale;
+	}
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::RotationFromTo(const TVec3<T>& from, const TVec3<T>& to)
+{
+	//Based on Stan Melax's article in Game Programming Gems
+	//Copy, since cannot modify local
+	TVec3<T> v0 = from;
+	TVec3<T> v1 = to;
+	v0.Normalize();
+	v1.Normalize();
+
+	const T d = PrecisionMath<T>::DotProduct3D(v0, v1);
+	if (d >= 1.0f) // If dot == 1, vectors are the same
+	{
+		return {};
+	}
+	else if (d <= -1.0f) // exactly opposite
+	{
+		TVec3<T> axis(1.0f, 0.f, 0.f);
+		axis = PrecisionMath<T>::CrossProduct3D(axis, v0);
+		if (axis.GetLengthSquared() == 0)
+		{
+			axis = TVec3<T>(0.f, 1.f, 0.f);
+			axis = PrecisionMath<T>::CrossProduct3D(axis, v0);
+		}
+		// same as fromAngleAxis(core::PI, axis).normalize();
+		return TQuat<T>(axis.x, axis.y, axis.z, 0).GetNormalized();
+	}
+
+	const T s = std::sqrt((1 + d) * 2); // optimize inv_sqrt
+	const T invs = 1.f / s;
+	const TVec3<T> c = PrecisionMath<T>::CrossProduct3D(v0, v1) * invs;
+	return TQuat<T>(c.x, c.y, c.z, s * 0.5f).GetNormalized();
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::Lerp(TQuat<T> q1, TQuat<T> q2, T zeroToOne)
+{
+	T oneMinus = 1.0f - zeroToOne;
+	return (q1 * oneMinus) + (q2 * zeroToOne);
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::SLerp(TQuat<T> q1, TQuat<T> q2, T t)
+{
+	TQuat<T> result;
+
+	T dot = q1.Dot(q2);
+	if (std::abs(dot) >= 1.0)
+	{
+		return q1;
+	}
+#if !defined(ENGINE_EXACT_MATH)
+	// Under about 0.8 degrees apart nlerp stays within 5e-8 radians of the slerp arc
+	if (dot > 0.9999)
+	{
+		return Lerp(q1, q2, t).GetNormalized();
+	}
+#endif
+	T angle = PrecisionMath<T>::FastAcos(dot);
+	T sinAngle = PrecisionMath<T>::FastSinRadians(angle);
+
+	T alpha = PrecisionMath<T>::FastSinRadians((1 - t) * angle) / sinAngle;
+	T beta = PrecisionMath<T>::FastSinRadians(t * angle) / sinAngle;
+
+	result.w = alpha * q1.w + beta * q2.w;
+	result.i = alpha * q1.i + beta * q2.i;
+	result.j = alpha * q1.j + beta * q2.j;
+	result.k = alpha * q1.k + beta * q2.k;
+
+	return result;
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::NLerp(TQuat<T> q1, TQuat<T> q2, T t)
+{
+	if (q1.Dot(q2) < 0.0)
+	{
+		q2 = q2 * -1.0;
+	}
+	return Lerp(q1, q2, t).GetNormalized();
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::ComputeQuaternion(TVec3<T> const& v)
+{
+	// Convert to axis-angle representation
+	T angle = v.GetLength();
+	if (angle < 1e-6f)
+	{
+		return TQuat(0, 0, 0, 1); // Identity quaternion for tiny corrections
+	}
+
+	// Create quaternion from axis-angle
+	T halfAngle = angle * 0.5f;
+	T sinHalfAngle = PrecisionMath<T>::FastSinRadians(halfAngle);
+
+	TQuat<T> result = TQuat<T>(v.x * sinHalfAngle, v.y * sinHalfAngle, v.z * sinHalfAngle, angle * PrecisionMath<T>::FastCosRadians(halfAngle)) * 1 / angle;
+
+	return result;
+}
+
+template <typename T>
+TVec3<T> TQuat<T>::ComputeAngleAxis(TQuat<T> const& q)
+{
+	T angle = 2 * std::acos(q.w);
+	T term = angle / std::sin(angle / 2);
+
+	TVec3<T> v;
+	v.x = term * q.i;
+	v.y = term * q.j;
+	v.z = term * q.k;
+
+	return v;
+}
+
+template <typename T>
+bool TQuat<T>::Equal(TQuat<T> const& q, T tolerance)
+{
+	bool iEqual = i < q.i + tolerance && i > q.i - tolerance;
+	bool jEqual = j < q.j + tolerance && j > q.j - tolerance;
+	bool kEqual = k < q.k + tolerance && k > q.k - tolerance;
+	bool wEqual = w < q.w + tolerance && w > q.w - tolerance;
+
+	return iEqual && jEqual && kEqual && wEqual;
+}
+
+template <typename T>
+T TQuat<T>::Dot(TQuat<T> const& q) const
+{
+	return (i * q.i) + (j * q.j) + (k * q.k) + (w * q.w);
+}
+
+template <typename T>
+T TQuat<T>::GetAngle()
+{
+	return 2 * std::acos(w);
+}
+
+template <typename T>
+TVec3<T> TQuat<T>::Rotate(const TVec3<T>& v) const
+{
+	TQuat<T> p(v);
+	TQuat<T> qInv = this->GetConjugated();
+	TQuat<T> rotated = *this * p * qInv;
+	return { rotated.i, rotated.j, rotated.k };
+}
+
+template <typename T>
+T TQuat<T>::GetMagnitude() const
+{
+	return std::sqrt(w * w + i * i + j * j + k * k);
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::GetConjugated() const
+{
+	return { -i, -j, -k, w };
+}
+
+template <typename T>
+void TQuat<T>::Conjugate()
+{
+	i = -i;
+	j = -j;
+	k = -k;
+}
+
+template <typename T>
+void TQuat<T>::Inverse()
+{
+	T norm = w * w + i * i + j * j + k * k;
+	w /= norm;
+	i /= -norm;
+	j /= -norm;
+	k /= -norm;
+}
+
+template <typename T>
+TQuat<T> TQuat<T>::GetInversed() const
+{
+	T norm = w * w + i * i + j * j + k * k;
+	return { -i / norm, -j / norm, -k / norm, w / norm };
+}
+
+template <typename T>
+const TQuat<T> TQuat<T>::operator+(const TQuat<T>& qToAdd) const
+{
+	return TQuat<T>(i + qToAdd.i, j + qToAdd.j, k + qToAdd.k, w + qToAdd.w);
+}
+
+template <typename T>
+const TQuat<T> TQuat<T>::operator-(const TQuat<T>& qToSubtract) const
+{
+	return TQuat<T>(i - qToSubtract.i, j - qToSubtract.j, k - qToSubtract.k, w - qToSubtract.w);
+}
+
+template <typename T>
+const TQuat<T> TQuat<T>::operator*(T uniformScale) const
+{
+	return TQuat<T>(i * uniformScale, j * uniformScale, k * uniformScale, w * uniformScale);
+}
+
+template <typename T>
+const TQuat<T> TQuat<T>::operator*(const TQuat<T>& qToMultiply) const
+{
+	TQuat<T> tmp;
+
+	tmp.w = (qToMultiply.w * w) - (qToMultiply.i * i) - (qToMultiply.j * j) - (qToMultiply.k * k);
+	tmp.i = (qToMultiply.w * i) + (qToMultiply.i * w) + (qToMultiply.j * k) - (qToMultiply.k * j);
+	tmp.j = (qToMultiply.w * j) + (qToMultiply.j * w) + (qToMultiply.k * i) - (qToMultiply.i * k);
+	tmp.k = (qToMultiply.w * k) + (qToMultiply.k * w) + (qToMultiply.i * j) - (qToMultiply.j * i);
+
+	return tmp;
+}
+
+template <typename T>
+void TQuat<T>::operator*=(const T uniformScale)
+{
+	i *= uniformScale;
+	j *= uniformScale;
+	k *= uniformScale;
+	w *= uniformScale;
+}
+
+template <typename T>
+void TQuat<T>::operator*=(const TQuat<T>& qToMultiply)
+{
+	*this = (*this) * qToMultiply;
+}
+
+template <typename T>
+const TVec3<T> TQuat<T>::operator*(TVec3<T> vecToMultiply) const
+{
+	// nVidia SDK implementation
+
+	TVec3<T> uv, uuv;
+	TVec3<T> qvec(i, j, k);
+	uv = PrecisionMath<T>::CrossProduct3D(qvec, vecToMultiply);
+	uuv = PrecisionMath<T>::CrossProduct3D(qvec, uv);
+	uv *= (2.0f * w);
+	uuv *= 2.0f;
+
+	return vecToMultiply + uv + uuv;
+}
+
+template <typename T>
+void TQuat<T>::operator=(const TQuat<T>& copjFrom)
+{
+	i = copjFrom.i;
+	j = copjFrom.j;
+	k = copjFrom.k;
+	w = copjFrom.w;
+}
+
+template <typename T>
+void TQuat<T>::operator/=(const T uniformDivisor)
+{
+	T oneOverDivisor = 1.f / uniformDivisor;
+	i *= oneOverDivisor;
+	j *= oneOverDivisor;
+	k *= oneOverDivisor;
+	w *= oneOverDivisor;
+}
+
+template <typename T>
+void TQuat<T>::operator-=(const TQuat<T>& qToSubtract)
+{
+	i -= qToSubtract.i;
+	j -= qToSubtract.j;
+	k -= qToSubtract.k;
+	w -= qToSubtract.w;
+}
+
+template <typename T>
+void TQuat<T>::operator+=(const TQuat<T>& qToAdd)
+{
+	i += qToAdd.i;
+	j += qToAdd.j;
+	k += qToAdd.k;
+	w += qToAdd.w;
+}
+
+template <typename T>
+const TQuat<T> TQuat<T>::operator/(T inverseScale) const
+{
+	T oneOverScale = 1.f / inverseScale;
+	return TQuat<T>(i * oneOverScale, j * oneOverScale, k * oneOverScale, w * oneOverScale);
+}
+
+template <typename T>
+bool TQuat<T>::operator!=(const TQuat<T>& compare) const
+{
+	return !(*this == compare);
+}
+
+template <typename T>
+bool TQuat<T>::operator==(const TQuat<T>& compare) const
+{
+	return i == compare.i && j == compare.j && k == compare.k && w == compare.w;
+}
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+//-----------------------------------------------------------------------------------------------
+// AVX versions of the hot double operators, {i, j, k, w} in one register
+template <>
+const TQuat<double> TQuat<double>::operator+(const TQuat<double>& qToAdd) const
+{
+	return StoreDoubleQuaternion(_mm256_add_pd(LoadDoubleQuaternion(*this), LoadDoubleQuaternion(qToAdd)));
+}
+
+template <>
+const TQuat<double> TQuat<double>::operator-(const TQuat<double>& qToSubtract) const
+{
+	return StoreDoubleQuaternion(_mm256_sub_pd(LoadDoubleQuaternion(*this), LoadDoubleQuaternion(qToSubtract)));
+}
+
+template <>
+const TQuat<double> TQuat<double>::operator*(double uniformScale) const
+{
+	return StoreDoubleQuaternion(_mm256_mul_pd(LoadDoubleQuaternion(*this), _mm256_set1_pd(uniformScale)));
+}
+
+template <>
+const TQuat<double> TQuat<double>::operator*(const TQuat<double>& qToMultiply) const
+{
+	// Lanes are {i, j, k, w}; each column below is one term of the scalar version, summed in the same order.
+	// The w row subtracts its second and third terms, so those lanes are negated before adding.
+	TQuat<double> const& q = qToMultiply;
+	__m256d term0 = _mm256_mul_pd(_mm256_set1_pd(q.w), LoadDoubleQuaternion(*this));
+	__m256d term1 = _mm256_mul_pd(_mm256_set_pd(q.i, q.k, q.j, q.i), _mm256_set_pd(i, w, w, w));
+	__m256d term2 = _mm256_mul_pd(_mm256_set_pd(q.j, q.i, q.k, q.j), _mm256_set_pd(j, j, i, k));
+	__m256d term3 = _mm256_mul_pd(_mm256_set_pd(q.k, q.j, q.i, q.k), _mm256_set_pd(k, i, k, j));
+
+	__m256d sum = _mm256_add_pd(term0, FlipSign(term1, false, false, false, true));
+	sum = _mm256_add_pd(sum, FlipSign(term2, false, false, false, true));
+	sum = _mm256_sub_pd(sum, term3);
+	return StoreDoubleQuaternion(sum);
+}
+
+template <>
+void TQuat<double>::operator=(const TQuat<double>& copjFrom)
+{
+	_mm256_store_pd(&i, LoadDoubleQuaternion(copjFrom));
+}
+#endif
+
+template struct TQuat<float>;
+template struct TQuat<double>;
@@ -0,0 +1,82 @@
+#pragma once
+#include "Engine/Math/TVec3.hpp"
+#include "Engine/Math/TMat44.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+
+//SOURCE: https://irrlicht.sourceforge.io/docu/quaternion_8h_source.html?fbclid=IwZXh0bgNhZW0CMTAAAR0kwVfx5jXQVhbodQtewKJ7pS6S5nOY70o7VwNy8G6oZdYyk02OOgOIe2Q_aem_ARWr5VLrwj54SUNrwqcZvP9zoPe_SEQuLk74XPXsfeWV7bLR0cXeqPPBzLlVjOuCQvRbiLtGhMTOgLboO3NNDQxf
+template <typename T>
+struct alignas(MathPrecisionTypes<T>::SIMD_ALIGNMENT) TQuat
+{
+public:
+	using OtherPrecision = typename MathPrecisionTypes<T>::OtherPrecision;
+
+	TQuat() = default;
+	TQuat(TQuat<OtherPrecision> q);
+	TQuat(TQuat const& copyFrom);
+	TQuat(T i, T j, T k);
+	TQuat(T i, T j, T k, T w);
+	explicit TQuat(EulerAngles const& eulerAngle);
+	explicit TQuat(TMat44<T> const& mat);
+	explicit TQuat(TVec3<T> const& rotationVec);
+	TQuat(T angle, TVec3<T> const& axis);
+
+	TMat44<T>		GetMatrix(TVec3<T> translation = TVec3<T>()) const;
+	TQuat			GetNormalized() const;
+	void			Normalize();
+	EulerAngles		ToEuler();
+	void			ToAngleAxis(T& out_angleRadian, TVec3<T>& out_axis) const;
+
+	bool			Equal(TQuat const& q, T tolerance = 0.005f);
+	T				Dot(TQuat const& q) const;
+	T				GetAngle();
+	TVec3<T>		Rotate(const TVec3<T>& v) const;
+
+	T				GetMagnitude() const;
+	void			Conjugate();
+	TQuat			GetConjugated() const;
+	void			Inverse();
+	TQuat			GetInversed() const;
+
+	static TQuat	RotationFromTo(const TVec3<T>& from, const TVec3<T>& to);
+	static TQuat	Lerp(TQuat q1, TQuat q2, T zeroToOne);
+	static TQuat	SLerp(TQuat q1, TQuat q2, T t);
+	static TQuat	NLerp(TQuat q1, TQuat q2, T t);	// shortest arc, cheap but not constant speed
+
+	static TQuat	ComputeQuaternion(TVec3<T> const& v);
+	static TVec3<T>	ComputeAngleAxis(TQuat const& q);
+
+
+	bool			operator==(const TQuat& compare) const;
+	bool			operator!=(const TQuat& compare) const;
+	const TQuat		operator+(const TQuat& qToAdd) const;
+	const TQuat		operator-(const TQuat& qToSubtract) const;
+	const TQuat		operator*(T uniformScale) const;
+	const TVec3<T>	operator*(TVec3<T> vecToMultiply) const;
+	const TQuat		operator/(T inverseScale) const;
+	const TQuat		operator*(const TQuat& qToMultiply) const;
+
+	// Operators (self-mutating / non-const)
+	void		operator+=(const TQuat& qToAdd);
+	void		operator-=(const TQuat& qToSubtract);
+	void		operator*=(const TQuat& qToMultiply);
+	void		operator*=(const T uniformScale);
+	void		operator/=(const T uniformDivisor);
+	void		operator=(const TQuat& copyFrom);
+
+public:
+	T i = 0.f;
+	T j = 0.f;
+	T k = 0.f;
+	T w = 1.f;
+};
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+template <> const TQuat<double> TQuat<double>::operator+(const TQuat<double>& qToAdd) const;
+template <> const TQuat<double> TQuat<double>::operator-(const TQuat<double>& qToSubtract) const;
+template <> const TQuat<double> TQuat<double>::operator*(double uniformScale) const;
+template <> const TQuat<double> TQuat<double>::operator*(const TQuat<double>& qToMultiply) const;
+template <> void TQuat<double>::operator=(const TQuat<double>& copyFrom);
+#endif
+
+extern template struct TQuat<float>;
+extern template struct TQuat<double>;
@@ -0,0 +1,484 @@
+#include "Engine/Math/TVec3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/DoubleVec2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/DoubleMathAVX.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cmath>
+
+template <typename T>
+TVec3<T>::TVec3(T initialX, T initialY, T initialZ)
+{
+	x = initialX;
+	y = initialY;
+	z = initialZ;
+}
+
+template <typename T>
+TVec3<T>::TVec3(TVec3<OtherPrecision> v)
+{
+	x = static_cast<T>(v.x);
+	y = static_cast<T>(v.y);
+	z = static_cast<T>(v.z);
+}
+
+template <typename T>
+TVec3<T>::TVec3(Vec2Type v2, T v2z)
+{
+	x = v2.x;
+	y = v2.y;
+	z = v2z;
+}
+
+template <typename T>
+TVec3<T> const TVec3<T>::MakeFromPolarRadians(T latitudeRadians, T longitudeRadians, T length)
+{
+	TVec3 v;
+	v.x = length * std::cos(latitudeRadians) * std::cos(longitudeRadians);
+	v.y = length * std::cos(latitudeRadians) * std::sin(longitudeRadians);
+	v.z = length * -std::sin(latitudeRadians);
+	return v;
+}
+
+template <typename T>
+TVec3<T> const TVec3<T>::MakeFromPolarDegrees(T latitudeDegrees, T longitudeDegrees, T length)
+{
+	TVec3 v;
+	v.x = length * PrecisionMath<T>::CosDegrees(latitudeDegrees) * PrecisionMath<T>::CosDegrees(longitudeDegrees);
+	v.y = length * PrecisionMath<T>::CosDegrees(latitudeDegrees) * PrecisionMath<T>::SinDegrees(longitudeDegrees);
+	v.z = length * -PrecisionMath<T>::SinDegrees(latitudeDegrees);
+	return v;
+}
+
+template <typename T>
+TVec3<T> TVec3<T>::Lerp(TVec3 const v1, TVec3 const v2, T t)
+{
+	return Interpolate(v1, v2, t);
+}
+
+template <typename T>
+TVec3<T> TVec3<T>::ZERO = TVec3<T>(0.f, 0.f, 0.f);
+
+template <typename T>
+void TVec3<T>::SetFromText(char const* text)
+{
+	Strings strings = SplitStringOnDelimiter(text, ',');
+
+	if (strings.size() != 3)
+	{
+		ERROR_AND_DIE("INPUT WRONG FORMAT VEC3");
+	}
+	const char* xChar = strings[0].c_str();
+	const char* yChar = strings[1].c_str();
+	const char* zChar = strings[2].c_str();
+
+	x = static_cast<T>(atof(xChar));
+	y = static_cast<T>(atof(yChar));
+	z = static_cast<T>(atof(zChar));
+}
+
+template <typename T>
+T TVec3<T>::GetLength() const
+{
+	return std::sqrt((x * x) + (y * y) + (z * z));
+}
+template <typename T>
+T TVec3<T>::GetLengthXY() const
+{
+	return std::sqrt((x * x) + (y * y));
+}
+template <typename T>
+T TVec3<T>::GetLengthSquared() const
+{
+	return (x * x) + (y * y) + (z * z);
+}
+template <typename T>
+T TVec3<T>::GetLengthXYSquared() const
+{
+	return (x * x) + (y * y);
+}
+template <typename T>
+T TVec3<T>::GetAngleAboutZRadians() const
+{
+	return std::atan2(y, x);
+}
+template <typename T>
+T TVec3<T>::GetAngleAboutZDegrees() const
+{
+	return PrecisionMath<T>::Atan2Degrees(y, x);
+}
+template <typename T>
+TVec3<T> const TVec3<T>::GetRotatedAboutZRadians(T deltaRadians) const
+{
+	// Find the new angle, then change x and y based on the new angle, keep z the same
+	T newThetaAngle = GetAngleAboutZRadians() + deltaRadians;
+	T newX = std::cos(newThetaAngle) * GetLengthXY();
+	T newY = std::sin(newThetaAngle) * GetLengthXY();
+	return TVec3(newX, newY, z);
+}
+template <typename T>
+TVec3<T> const TVec3<T>::GetRotatedAboutZDegrees(T deltaDegrees) const
+{
+	// Find the new angle, then change x and y based on the new angle, keep z the same
+	T newThetaAngle = GetAngleAboutZDegrees() + deltaDegrees;
+	T newX = PrecisionMath<T>::CosDegrees(newThetaAngle) * GetLengthXY();
+	T newY = PrecisionMath<T>::SinDegrees(newThetaAngle) * GetLengthXY();
+	return TVec3(newX, newY, z);
+}
+template <typename T>
+TVec3<T> const TVec3<T>::GetClamped(T maxLength) const
+{
+	T length = GetLength();
+	if (length <= 0.f) return TVec3(0.f, 0.f, 0.f);
+	if (length >= maxLength) return TVec3(x, y, z);
+	T scale = maxLength / length;
+	return TVec3(x * scale, y * scale, z * scale);
+}
+template <typename T>
+TVec3<T> const TVec3<T>::GetNormalized() const
+{
+	T lengthSquared = GetLengthSquared();
+	if (lengthSquared <= 0.f) return TVec3(0.f, 0.f, 0.f);
+	T scale = PrecisionMath<T>::FastInverseSqrt(lengthSquared);
+	return TVec3(x * scale, y * scale, z * scale);
+}
+
+template <typename T>
+TVec3<T> const TVec3<T>::GetAbsolute() const
+{
+	return TVec3(std::fabs(x), std::fabs(y), std::fabs(z));
+}
+
+template <typename T>
+TVec3<T> const TVec3<T>::GetPerpendicularVector() const
+{
+	TVec3 perpVector;
+	if (std::fabs(x) < std::fabs(y) && std::fabs(x) < std::fabs(z))
+	{
+		perpVector = TVec3(1, 0, 0);
+	}
+	else if (std::fabs(y) < std::fabs(x) && std::fabs(y) < std::fabs(z))
+	{
+		perpVector = TVec3(0, 1, 0);
+	}
+	else
+	{
+		perpVector = TVec3(0, 0, 1);
+	}
+	return PrecisionMath<T>::CrossProduct3D(*this, perpVector).GetNormalized();
+}
+
+template <typename T>
+TVec3<T> TVec3<T>::GetPerpendicularVectorAroundThisAxis(TVec3 axis) const
+{
+	TVec3 v = *this;
+	TVec3 normalizedAxis = axis;
+	normalizedAxis.Normalize();
+
+	// Check if the vectors are not parallel
+	if (std::fabs(v.x * normalizedAxis.x + v.y * normalizedAxis.y + v.z * normalizedAxis.z) < 0.99999) {
+		// Use cross product to find a perpendicular vector
+		TVec3 perpendicular = v.Cross(normalizedAxis);
+		perpendicular.Normalize();
+		return perpendicular;
+	}
+	else {
+		// The vectors are parallel, so we need to choose an arbitrary perpendicular vector
+		TVec3 arbitrary(1, 0, 0);
+		if (std::abs(normalizedAxis.x) > 0.99999) {
+			arbitrary = TVec3(0, 1, 0);
+		}
+		TVec3 perpendicular = normalizedAxis.Cross(arbitrary);
+		perpendicular.Normalize();
+		return perpendicular;
+	}
+}
+
+template <typename T>
+bool TVec3<T>::IsDifferent(TVec3 compare, T tolerance)
+{
+	using RangeType = typename MathPrecisionTypes<T>::RangeType;
+	RangeType xRange = RangeType(x - tolerance, x + tolerance);
+	RangeType yRange = RangeType(y - tolerance, y + tolerance);
+	RangeType zRange = RangeType(z - tolerance, z + tolerance);
+
+	if (xRange.IsOnRange(compare.x) && yRange.IsOnRange(compare.y) && zRange.IsOnRange(compare.z))
+	{
+		return false;
+	}
+	else
+	{
+		return true;
+	}
+}
+
+template <typename T>
+T TVec3<T>::GetAngleDegreeFromThisVector(const TVec3& axis)
+{
+	T dot = this->Dot(axis);
+
+	T angle = PrecisionMath<T>::ConvertRadiansToDegrees(std::acos(dot / (GetLength() * axis.GetLength())));
+
+	if (angle < 0)
+	{
+		angle += 360.f;
+	}
+	if (angle > 360.f)
+	{
+		angle -= 360.f;
+	}
+	return angle;
+}
+
+template <typename T>
+void TVec3<T>::LerpTo(TVec3& goal, T t)
+{
+	Interpolate(*this, goal, t);
+}
+
+template <typename T>
+void TVec3<T>::UniformClamp(T min, T max)
+{
+	x = PrecisionMath<T>::Clamp(x, min, max);
+	y = PrecisionMath<T>::Clamp(y, min, max);
+	z = PrecisionMath<T>::Clamp(z, min, max);
+}
+
+template <typename T>
+void TVec3<T>::SetLength(T newLength)
+{
+	T ratio = newLength / GetLength();
+	x *= ratio;
+	y *= ratio;
+	z *= ratio;
+}
+
+template <>
+void TVec3<double>::SetLength(double newLength)
+{
+	Normalize();
+	*this *= newLength;
+}
+
+template <typename T>
+void TVec3<T>::ClampLength(T maxLength)
+{
+	T length = GetLength();
+	if (length <= 0) return;
+	if (length <= maxLength) return;
+	T scale = maxLength / length;
+	x *= scale;
+	y *= scale;
+	z *= scale;
+}
+
+template <typename T>
+void TVec3<T>::Normalize()
+{
+	T lengthSquared = GetLengthSquared();
+	if (lengthSquared <= 0.f)
+	{
+		x = 0.f;
+		y = 0.f;
+		z = 0.f;
+	}
+	else
+	{
+		T scale = PrecisionMath<T>::FastInverseSqrt(lengthSquared);
+		x *= scale;
+		y *= scale;
+		z *= scale;
+	}
+}
+
+template <typename T>
+T TVec3<T>::Dot(const TVec3& v) const
+{
+	return PrecisionMath<T>::DotProduct3D(*this, v);
+}
+
+template <typename T>
+TVec3<T> TVec3<T>::Cross(const TVec3& v) const
+{
+	return PrecisionMath<T>::CrossProduct3D(*this, v);
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+bool TVec3<T>::operator==(const TVec3& compare) const
+{
+	return 	PrecisionMath<T>::Equal(x, compare.x, 0.00001f)
+		&& PrecisionMath<T>::Equal(y, compare.y, 0.00001f)
+		&& PrecisionMath<T>::Equal(z, compare.z, 0.00001f);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+bool TVec3<T>::operator!=(const TVec3& compare) const
+{
+	return x != compare.x || y != compare.y || z != compare.z;
+}
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+const TVec3<T> TVec3<T>::operator+(const TVec3& vecToAdd) const
+{
+	return TVec3(x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+const TVec3<T> TVec3<T>::operator-(const TVec3& vecToSubtract) const
+{
+	return TVec3(x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z);
+}
+
+template <typename T>
+const TVec3<T> TVec3<T>::operator-() const
+{
+	return TVec3(-x, -y, -z);
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+const TVec3<T> TVec3<T>::operator*(T uniformScale) const
+{
+	return TVec3(x * uniformScale, y * uniformScale, z * uniformScale);
+}
+
+template <typename T>
+const TVec3<T> TVec3<T>::operator*(const TVec3& vecToMultiply) const
+{
+	T newx = x * vecToMultiply.x;
+	T newy = y * vecToMultiply.y;
+	T newz = z * vecToMultiply.z;
+	return TVec3(newx, newy, newz);
+}
+
+template <typename T>
+TVec3<T> const operator*(typename TVec3<T>::ValueType uniformScale, const TVec3<T>& vecToScale)
+{
+	T x = vecToScale.x * uniformScale;
+	T y = vecToScale.y * uniformScale;
+	T z = vecToScale.z * uniformScale;
+	return TVec3<T>(x, y, z);
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+const TVec3<T> TVec3<T>::operator/(T inverseScale) const
+{
+	T scale = 1.f / inverseScale;
+	return TVec3(x * scale, y * scale, z * scale);
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+void TVec3<T>::operator+=(const TVec3& vecToAdd)
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+void TVec3<T>::operator-=(const TVec3& vecToSubtract)
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+void TVec3<T>::operator*=(T uniformScale)
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+void TVec3<T>::operator/=(T uniformDivisor)
+{
+	T scale = 1.f / uniformDivisor;
+	x *= scale;
+	y *= scale;
+	z *= scale;
+}
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+void TVec3<T>::operator=(const TVec3& copyFrom)
+{
+	x = copyFrom.x;
+	y = copyFrom.y;
+	z = copyFrom.z;
+}
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+//-----------------------------------------------------------------------------------------------
+// AVX versions of the hot double operators, one register per vector
+template <>
+const TVec3<double> TVec3<double>::operator+(const TVec3<double>& vecToAdd) const
+{
+	return StoreDoubleVec3(_mm256_add_pd(LoadDoubleVec3(*this), LoadDoubleVec3(vecToAdd)));
+}
+
+template <>
+const TVec3<double> TVec3<double>::operator-(const TVec3<double>& vecToSubtract) const
+{
+	return StoreDoubleVec3(_mm256_sub_pd(LoadDoubleVec3(*this), LoadDoubleVec3(vecToSubtract)));
+}
+
+template <>
+const TVec3<double> TVec3<double>::operator-() const
+{
+	return StoreDoubleVec3(FlipSign(LoadDoubleVec3(*this), true, true, true, false));
+}
+
+template <>
+const TVec3<double> TVec3<double>::operator*(double uniformScale) const
+{
+	return StoreDoubleVec3(_mm256_mul_pd(LoadDoubleVec3(*this), _mm256_set1_pd(uniformScale)));
+}
+
+template <>
+const TVec3<double> TVec3<double>::operator*(const TVec3<double>& vecToMultiply) const
+{
+	return StoreDoubleVec3(_mm256_mul_pd(LoadDoubleVec3(*this), LoadDoubleVec3(vecToMultiply)));
+}
+
+template <>
+void TVec3<double>::operator+=(const TVec3<double>& vecToAdd)
+{
+	StoreDoubleVec3(*this, _mm256_add_pd(LoadDoubleVec3(*this), LoadDoubleVec3(vecToAdd)));
+}
+
+template <>
+void TVec3<double>::operator-=(const TVec3<double>& vecToSubtract)
+{
+	StoreDoubleVec3(*this, _mm256_sub_pd(LoadDoubleVec3(*this), LoadDoubleVec3(vecToSubtract)));
+}
+
+template <>
+void TVec3<double>::operator*=(const double uniformScale)
+{
+	StoreDoubleVec3(*this, _mm256_mul_pd(LoadDoubleVec3(*this), _mm256_set1_pd(uniformScale)));
+}
+
+template <>
+void TVec3<double>::operator=(const TVec3<double>& copyFrom)
+{
+	_mm256_store_pd(&x, LoadDoubleVec3(copyFrom));
+}
+#endif
+
+template struct TVec3<float>;
+template struct TVec3<double>;
+template TVec3<float> const operator*(float uniformScale, const TVec3<float>& vecToScale);
+template TVec3<double> const operator*(double uniformScale, const TVec3<double>& vecToScale);
@@ -0,0 +1,114 @@
+#pragma once
+#include "Engine/Math/MathPrecision.hpp"
+
+//-----------------------------------------------------------------------------------------------
+// Components live in a base so the AVX build can give the double version its fourth lane
+template <typename T>
+struct TVec3Components
+{
+	T x = 0.f;
+	T y = 0.f;
+	T z = 0.f;
+};
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+template <>
+struct alignas(32) TVec3Components<double>
+{
+	double x = 0.f;
+	double y = 0.f;
+	double z = 0.f;
+	double pad = 0.f;	// fourth AVX lane, kept at zero
+};
+#endif
+
+//-----------------------------------------------------------------------------------------------
+template <typename T>
+struct TVec3 : public TVec3Components<T>
+{
+public: // NOTE: this is one of the few cases where we break both the "m_" naming rule AND the avoid-public-members rule
+	using TVec3Components<T>::x;
+	using TVec3Components<T>::y;
+	using TVec3Components<T>::z;
+
+	using ValueType = T;
+	using Vec2Type = typename MathPrecisionTypes<T>::Vec2Type;
+	using OtherPrecision = typename MathPrecisionTypes<T>::OtherPrecision;
+
+	TVec3() = default;
+	TVec3(T initialX, T initialY, T initialZ);
+	TVec3(TVec3<OtherPrecision> v);
+	TVec3(Vec2Type v2, T v2z);
+
+	static TVec3 ZERO;
+
+	static TVec3 const MakeFromPolarRadians(T latitudeRadians, T longitudeRadians, T length = 1.f);
+	static TVec3 const MakeFromPolarDegrees(T latitudeDegrees, T longitudeDegrees, T length = 1.f);
+
+	static TVec3 Lerp(TVec3 const v1, TVec3 const v2, T t);
+
+	void SetFromText(char const* text);
+	//Accessors
+	T			GetLength() const;
+	T			GetLengthXY() const;
+	T			GetLengthSquared() const;
+	T			GetLengthXYSquared() const;
+	T			GetAngleAboutZRadians() const;
+	T			GetAngleAboutZDegrees() const;
+	TVec3 const	GetRotatedAboutZRadians(T deltaRadians) const;
+	TVec3 const	GetRotatedAboutZDegrees(T deltaDegrees) const;
+	TVec3 const	GetClamped(T maxLength) const;
+	TVec3 const	GetNormalized() const;
+	TVec3 const	GetAbsolute() const;
+	TVec3 const	GetPerpendicularVector() const;
+	TVec3		GetPerpendicularVectorAroundThisAxis(TVec3 axis) const;
+	bool		IsDifferent(TVec3 compare, T tolerance = 0.f);
+	T			GetAngleDegreeFromThisVector(const TVec3& axis);
+	void		LerpTo(TVec3& goal, T t);
+	void		UniformClamp(T min, T max);
+
+	void		SetLength(T newLength);
+	void		ClampLength(T maxLength);
+	void		Normalize();
+	T			Dot(const TVec3& v) const;
+	TVec3		Cross(const TVec3& v) const;
+	// Operators (const)
+	bool		operator==(const TVec3& compare) const;
+	bool		operator!=(const TVec3& compare) const;
+	const TVec3	operator+(const TVec3& vecToAdd) const;
+	const TVec3	operator-(const TVec3& vecToSubtract) const;
+	const TVec3	operator-() const;
+	const TVec3	operator*(T uniformScale) const;
+	const TVec3	operator/(T inverseScale) const;
+	const TVec3	operator*(const TVec3& vecToMultiply) const;
+
+	// Operators (self-mutating / non-const)
+	void		operator+=(const TVec3& vecToAdd);
+	void		operator-=(const TVec3& vecToSubtract);
+	void		operator*=(const T uniformScale);
+	void		operator/=(const T uniformDivisor);
+	void		operator=(const TVec3& copyFrom);
+};
+
+// Standalone function that is conceptually, but not actually, part of TVec3::
+// The scale is not deduced, so 2.f * doubleVec still picks the double version
+template <typename T>
+TVec3<T> const operator*(typename TVec3<T>::ValueType uniformScale, const TVec3<T>& vecToScale);
+
+// The double version has always set its length through Normalize()
+template <> void TVec3<double>::SetLength(double newLength);
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+template <> const TVec3<double> TVec3<double>::operator+(const TVec3<double>& vecToAdd) const;
+template <> const TVec3<double> TVec3<double>::operator-(const TVec3<double>& vecToSubtract) const;
+template <> const TVec3<double> TVec3<double>::operator-() const;
+template <> const TVec3<double> TVec3<double>::operator*(double uniformScale) const;
+template <> const TVec3<double> TVec3<double>::operator*(const TVec3<double>& vecToMultiply) const;
+template <> void TVec3<double>::operator+=(const TVec3<double>& vecToAdd);
+template <> void TVec3<double>::operator-=(const TVec3<double>& vecToSubtract);
+template <> void TVec3<double>::operator*=(const double uniformScale);
+template <> void TVec3<double>::operator=(const TVec3<double>& copyFrom);
+#endif
+
+extern template struct TVec3<float>;
+extern template struct TVec3<double>;
@@ -1,8 +1,8 @@
 #pragma once
+#include "Engine/Math/MathPrecision.hpp"
 #include <math.h>
 
 struct IntVec2;
-struct Vec3;
 
 //-----------------------------------------------------------------------------------------------
 struct Vec2
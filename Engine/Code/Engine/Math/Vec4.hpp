@@ -1,9 +1,8 @@
 #pragma once
-
+#include "Engine/Math/MathPrecision.hpp"
 
 //-----------------------------------------------------------------------------------------------
 struct Vec2;
-struct Vec3;
 
 struct Vec4
 {
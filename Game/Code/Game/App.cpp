@@ -62,6 +62,8 @@ void App::Startup()
 	debugrenderConfig.m_renderer = g_theRenderer;
 
 	JobSystemConfig jobSysConfig;
+	jobSysConfig.m_pinWorkers = true;
+	jobSysConfig.m_threadNamePrefix = "Ragdoll Worker";
 	g_theJobSystem = new JobSystem(jobSysConfig);
 
 	Clock::s_theSystemClock->TickSystemClock();
@@ -87,6 +89,7 @@ void App::Startup()
 	g_theGame->Startup();
 
 	SubscribeEventCallbackFunction("quit", App::Event_Quit);
+	SubscribeEventCallbackFunction("jobbenchmark", App::Event_JobBenchmark);
 
 	ConsoleTutorial();
 
@@ -110,6 +113,32 @@ bool App::Event_Quit(EventArgs& args)
 	return false;
 }
 
+// "jobbenchmark idle=1.0 samples=200": idle CPU of the parked workers and queue-to-start latency
+bool App::Event_JobBenchmark(EventArgs& args)
+{
+	float idleSeconds = args.GetValue("idle", 1.f);
+	int numSamples = args.GetValue("samples", 200);
+
+	// Console commands run while last frame's step may still be on the workers
+	if (g_theGame)
+	{
+		g_theGame->SyncSimulationStep();
+	}
+
+	JobSystemBenchmarkResult result = RunJobSystemBenchmark(g_theJobSystem, (double)idleSeconds, numSamples);
+
+	std::string lines[3];
+	lines[0] = Stringf("Job benchmark: %i workers, idle %.2fs burned %.3f CPU seconds (%.3f cores)", (int)g_theJobSystem->GetWorkersSize(), result.m_idleSeconds, result.m_idleCPUSeconds, result.m_idleCores);
+	lines[1] = Stringf("Queue-to-start after park: avg %.1fus, max %.1fus over %i jobs", result.m_coldLatencyAvgMicroseconds, result.m_coldLatencyMaxMicroseconds, result.m_numLatencySamples);
+	lines[2] = Stringf("Queue-to-start while awake: avg %.1fus, max %.1fus over %i jobs", result.m_hotLatencyAvgMicroseconds, result.m_hotLatencyMaxMicroseconds, result.m_numLatencySamples);
+	for (std::string const& line : lines)
+	{
+		DebuggerPrintf("%s\n", line.c_str());
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, line);
+	}
+	return true;
+}
+
 void App::Shutdown()
 {
 	ImGui_ImplDX11_Shutdown();
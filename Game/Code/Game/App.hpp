@@ -45,6 +45,7 @@ public:
 	void Render() const;
 	void EndFrame();
 	static bool Event_Quit(EventArgs& args);
+	static bool Event_JobBenchmark(EventArgs& args);
 
 	bool m_isQuitting = false;
 
@@ -1,5 +1,6 @@
 #include "Game/Game.hpp"
 #include "Game/Player.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 constexpr float CANNON_CHARGE_RATE = 32000.f;
 constexpr float CANNON_CHARGE_LIMIT = 64000.f;
@@ -57,6 +58,14 @@ void Game::Startup()
 	m_allObjects.reserve(400);
 	m_fixedObjects.reserve(30);
 
+	SubscribeEventCallbackFunction("collisionstats", Game::Event_CollisionStats);
+	SubscribeEventCallbackFunction("deterministic", Game::Event_Deterministic);
+	SubscribeEventCallbackFunction("worldstate", Game::Event_WorldState);
+	SubscribeEventCallbackFunction("replay", Game::Event_Replay);
+	SubscribeEventCallbackFunction("solverbench", Game::Event_SolverBench);
+	SubscribeEventCallbackFunction("narrowphasebench", Game::Event_NarrowphaseBench);
+	SubscribeEventCallbackFunction("precisionbench", Game::Event_PrecisionBench);
+
 	Menu_Init();
 
 	SwitchState(GameState::ATTRACT_MODE); // Player Init here
@@ -66,6 +75,9 @@ void Game::Startup()
 
 void Game::Update(float deltaSeconds)
 {
+	// The step queued last frame has to finish before anything below touches the ragdolls
+	SyncSimulationStep();
+
 	m_secondIntoMode += deltaSeconds;
 
 	HandleInput();
@@ -91,6 +103,14 @@ void Game::Update(float deltaSeconds)
 	{
 		UpdateCannonMode(deltaSeconds);
 	}
+
+	if (m_replayPlayer.IsLoaded() && m_isReplayPlaying)
+	{
+		m_replayTime += deltaSeconds;
+		m_replayPlayer.SeekToFrame((int)(m_replayTime / m_replayPlayer.GetStepSeconds()));
+	}
+
+	KickSimulationStep();
 }
 //..............................
 void Game::UpdateFeatureMode(float deltaSeconds)
@@ -316,9 +336,16 @@ void Game::RenderFeatureMode() const
 		DrawGrid();
 	}
 
-	for (auto& r : m_ragdolls)
+	if (m_replayPlayer.IsLoaded())
 	{
-		r->Render();
+		m_replayPlayer.Render();
+	}
+	else
+	{
+		for (auto& r : m_ragdolls)
+		{
+			r->Render();
+		}
 	}
 
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
@@ -376,9 +403,16 @@ void Game::RenderPachinkoMode() const
 
 	DrawSkybox();
 
-	for (auto& r : m_ragdolls)
+	if (m_replayPlayer.IsLoaded())
 	{
-		r->Render();
+		m_replayPlayer.Render();
+	}
+	else
+	{
+		for (auto& r : m_ragdolls)
+		{
+			r->Render();
+		}
 	}
 
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
@@ -446,9 +480,16 @@ void Game::RenderCannonMode() const
 	g_theRenderer->BindTexture(m_planeTextureS, 2);
 	g_theRenderer->DrawIndexedBuffer(m_planeVBO, m_planeIBO, m_planeIndexes.size(), 0, VertexType::Vertex_PCUTBN);
 
-	for (auto& r : m_ragdolls)
+	if (m_replayPlayer.IsLoaded())
 	{
-		r->Render();
+		m_replayPlayer.Render();
+	}
+	else
+	{
+		for (auto& r : m_ragdolls)
+		{
+			r->Render();
+		}
 	}
 
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
@@ -559,6 +600,10 @@ void Game::DrawSkybox() const
 //..............................
 void Game::Shutdown()
 {
+	SyncSimulationStep();
+	m_replayRecorder.Stop();
+	m_replayPlayer.Unload();
+
 	for (auto& r : m_ragdolls)
 	{
 		delete r;
@@ -580,6 +625,9 @@ void Game::Shutdown()
 void Game::Restart()
 {
 	m_ragdollRaycastResult = RaycastRagdollResult3D();
+	m_simulationStep = 0;
+	m_stepChecksum = 0;
+	m_timeDebt = 0.f;
 
 	if (m_currentState == GameState::FEATURE_MODE)
 	{
@@ -634,13 +682,13 @@ void Game::Init_Ragdolls()
 void Game::Init_Octree()
 {
 	m_octree = new Octree(DoubleAABB3(-1024, -1024, -1024, 1024, 1024, 1024), m_allObjects);
-	m_octree->m_isRoot = true;
-	m_octree->Init();
 	m_octree->UpdateTree();
 }
 
 void Game::Update_Ragdolls(float deltaSeconds)
 {
+	if (m_replayPlayer.IsLoaded()) return;
+
 	if (DEBUG_usingMultithreading)
 	{
 		ManagingRagdolls_Multi_Threaded(deltaSeconds);
@@ -667,39 +715,27 @@ void Game::Update_Ragdolls(float deltaSeconds)
 
 			if (g_theInput->IsKeyDown('A'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(0, 1, 0) * -DEBUG_NodeMoveSpeed * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(0, 1, 0) * -DEBUG_NodeMoveSpeed * deltaSeconds);
 			}
 			if (g_theInput->IsKeyDown('D'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(0, 1, 0) * DEBUG_NodeMoveSpeed * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(0, 1, 0) * DEBUG_NodeMoveSpeed * deltaSeconds);
 			}
 			if (g_theInput->IsKeyDown('W'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(1, 0, 0) * -DEBUG_NodeMoveSpeed * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(1, 0, 0) * -DEBUG_NodeMoveSpeed * deltaSeconds);
 			}
 			if (g_theInput->IsKeyDown('S'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(1, 0, 0) * DEBUG_NodeMoveSpeed * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(1, 0, 0) * DEBUG_NodeMoveSpeed * deltaSeconds);
 			}
 			if (g_theInput->IsKeyDown('Q'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(0, 0, 1) * DEBUG_NodeMoveSpeed * 2 * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(0, 0, 1) * DEBUG_NodeMoveSpeed * 2 * deltaSeconds);
 			}
 			if (g_theInput->IsKeyDown('E'))
 			{
-				m_ragdolls[0]->ApplyGlobalAcceleration(DoubleVec3(0, 0, 1) * -DEBUG_NodeMoveSpeed * 2 * deltaSeconds);
-				m_ragdolls[0]->m_deadTimer = DEBUG_ragdoll_deadTimer;
-				m_ragdolls[0]->m_timeSinceSpawn = 0.f;
+				PushRagdoll(m_ragdolls[0], DoubleVec3(0, 0, 1) * -DEBUG_NodeMoveSpeed * 2 * deltaSeconds);
 			}
 		}
 	}
@@ -709,42 +745,154 @@ void Game::ManagingRagdolls_Single_Threaded(float deltaSeconds)
 {
 	if (m_ragdolls.empty() || !m_octree) return;
 
-	for (auto& r : m_ragdolls)
+	if (!DEBUG_deterministic)
 	{
-		r->Update(deltaSeconds);
+		UpdateRagdollTimers(deltaSeconds);
+	}
 
-		if (DEBUG_allRagdollLiveForever)
-		{
-			r->m_isDead = false;
-		}
+	StepRagdolls_Serial(ConsumeTimeDebt(deltaSeconds));
+}
+
+void Game::ManagingRagdolls_Multi_Threaded(float deltaSeconds)
+{
+	if (m_ragdolls.empty() || !m_octree) return;
+
+	// Contacts are resolved on the job system too, so nothing below may overlap a step that is still integrating
+	SyncSimulationStep();
+
+	if (!DEBUG_deterministic)
+	{
+		UpdateRagdollTimers(deltaSeconds);
 	}
 
-	m_timeDebt += deltaSeconds;
-	while (m_timeDebt >= m_fixedTimeStep)
+	size_t numActiveRagdolls = 0;
+	for (auto& ragdoll : m_ragdolls)
 	{
-		for (auto& r : m_ragdolls)
+		if (ragdoll && !ragdoll->m_isDead)
 		{
-			r->SolveOneIteration(m_fixedTimeStep);
+			numActiveRagdolls++;
 		}
+	}
 
+	// A deterministic run only ever touches the tree once per fixed step
+	if (numActiveRagdolls == 0 && !DEBUG_deterministic)
+	{
 		m_octree->Update();
+		return;
+	}
 
-		m_timeDebt -= m_fixedTimeStep;
+	bool useMultithreading = (numActiveRagdolls >= MULTITHREADING_THRESHOLD);
+	int iterations = ConsumeTimeDebt(deltaSeconds);
+
+	// Single-threaded 
+	if (!useMultithreading)
+	{
+		StepRagdolls_Serial(iterations);
+		return;
+	}
+
+	//-------------------------------------------------------------
+	// Multi-threaded 
+	// Each fixed step is a graph: integrate every ragdoll -> refit -> broadphase -> narrowphase/resolve -> prune -> finish,
+	// and the next step's integration waits on this step's finish
+
+	// The graph is only queued at the end of Game::Update, once input and spawning are done with the ragdolls.
+	// The octree may be rebuilt before then, so the jobs look it up when they run
+	FunctionJob* previousStep = nullptr;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		FunctionJob* integrate = g_theJobSystem->CreateJob([this]()
+		{
+			if (DEBUG_deterministic)
+			{
+				UpdateRagdollTimers(m_fixedTimeStep);
+			}
+
+			g_theJobSystem->ParallelFor(0, (int)m_ragdolls.size(), 1, [this](int r)
+			{
+				// The serial path solves dead ragdolls too, and a deterministic run has to match it
+				Ragdoll* ragdoll = m_ragdolls[r];
+				if (ragdoll && (!ragdoll->m_isDead || DEBUG_deterministic))
+				{
+					ragdoll->SolveOneIteration(m_fixedTimeStep);
+				}
+			});
+		});
+		FunctionJob* refit = g_theJobSystem->CreateJob([this]() { m_octree->RefitObjects(); });
+		FunctionJob* broadphase = g_theJobSystem->CreateJob([this]() { m_octree->FindCollisionPairs(); });
+		FunctionJob* resolve = g_theJobSystem->CreateJob([this]() { m_octree->ResolveCollisionPairs(); });
+		FunctionJob* prune = g_theJobSystem->CreateJob([this]() { m_octree->Maintain(); });
+		FunctionJob* finish = g_theJobSystem->CreateJob([this]() { FinishSimulationStep(); });
+
+		if (previousStep) integrate->AddDependency(previousStep);
+		refit->AddDependency(integrate);
+		broadphase->AddDependency(refit);
+		resolve->AddDependency(broadphase);
+		prune->AddDependency(resolve);
+		finish->AddDependency(prune);
+
+		m_stepJobs.push_back(integrate);
+		m_stepJobs.push_back(refit);
+		m_stepJobs.push_back(broadphase);
+		m_stepJobs.push_back(resolve);
+		m_stepJobs.push_back(prune);
+		m_stepJobs.push_back(finish);
+		previousStep = finish;
 	}
 }
 
-void Game::ManagingRagdolls_Multi_Threaded(float deltaSeconds)
+void Game::KickSimulationStep()
 {
-	if (m_ragdolls.empty() || !m_octree) return;
+	if (!m_stepJobs.empty() && !m_isStepInFlight)
+	{
+		for (auto& job : m_stepJobs)
+		{
+			job->m_priority = JobPriority::CRITICAL;
+		}
+		g_theJobSystem->QueueJobs(m_stepJobs.data(), m_stepJobs.size(), m_stepCounter);
+		m_isStepInFlight = true;
+	}
 
-	// Process completed jobs from previous frames
-	for (size_t i = 0; i < g_theJobSystem->GetNumCompletedJobs(); i++)
+	// Debug draw reads live node and octree state, so it always gets a finished step.
+	// When nothing was queued the step already ran serially and there is nothing to overlap with
+	if (!DEBUG_overlapSimulation || DEBUG_DebugDraw || !m_isStepInFlight)
 	{
-		Job* job = g_theJobSystem->RetrieveJob();
-		delete job;
+		SyncSimulationStep();
 	}
+}
+
+// The main thread helps run whatever is left of the graph, then flips the render snapshots
+void Game::SyncSimulationStep()
+{
+	if (m_isStepInFlight)
+	{
+		g_theJobSystem->Wait(m_stepCounter);
+		for (auto& job : m_stepJobs)
+		{
+			g_theJobSystem->ReleaseJob(job);
+		}
+		m_stepJobs.clear();
+		m_isStepInFlight = false;
+	}
+
+	if (m_hasNewRenderSnapshot)
+	{
+		m_renderSnapshotIndex ^= 1;
+		m_hasNewRenderSnapshot = false;
+	}
+
+	// Every step up to the time debt is in the front snapshot now, so the debt is exactly how far past it to draw
+	m_renderAlpha = DEBUG_interpolateRender ? Clamp(m_timeDebt / m_fixedTimeStep, 0.f, 1.f) : 1.f;
 
-	size_t numActiveRagdolls = 0;
+	for (auto& ragdoll : m_ragdolls)
+	{
+		ragdoll->ReleaseBrokenConstraints();
+	}
+}
+
+void Game::UpdateRagdollTimers(float deltaSeconds)
+{
 	for (auto& ragdoll : m_ragdolls)
 	{
 		if (!ragdoll) continue;
@@ -755,64 +903,184 @@ void Game::ManagingRagdolls_Multi_Threaded(float deltaSeconds)
 		{
 			ragdoll->m_isDead = false;
 		}
+	}
+}
+
+// Both paths step from the same time debt, so they take the same number of steps for the same frames
+int Game::ConsumeTimeDebt(float deltaSeconds)
+{
+	m_timeDebt += deltaSeconds;
+
+	int iterations = 0;
+	while (m_timeDebt >= m_fixedTimeStep)
+	{
+		m_timeDebt -= m_fixedTimeStep;
+		iterations++;
+	}
+	return iterations;
+}
 
-		if (!ragdoll->m_isDead)
+void Game::StepRagdolls_Serial(int iterations)
+{
+	for (int i = 0; i < iterations; i++)
+	{
+		if (DEBUG_deterministic)
 		{
-			numActiveRagdolls++;
+			UpdateRagdollTimers(m_fixedTimeStep);
+		}
+
+		for (auto& r : m_ragdolls)
+		{
+			r->SolveOneIteration(m_fixedTimeStep);
 		}
+
+		m_octree->Update();
+		FinishSimulationStep();
 	}
+}
 
-	if (numActiveRagdolls == 0)
+void Game::FinishSimulationStep()
+{
+	m_simulationStep++;
+
+	for (auto& ragdoll : m_ragdolls)
 	{
-		m_octree->Update();
-		return;
+		ragdoll->PublishRenderSnapshot(m_renderSnapshotIndex ^ 1);
 	}
+	m_hasNewRenderSnapshot = true;
+	m_replayRecorder.RecordStep(m_simulationStep, m_ragdolls);
 
-	bool useMultithreading = (numActiveRagdolls >= MULTITHREADING_THRESHOLD);
-	int iterations = IntMax(1, (int)(deltaSeconds / m_fixedTimeStep));
+	if (!DEBUG_deterministic) return;
 
-	// Single-threaded 
-	if (!useMultithreading)
+	m_stepChecksum = ComputeSimulationChecksum();
+	if (DEBUG_logStepChecksums)
 	{
-		m_timeDebt += deltaSeconds;
-		while (m_timeDebt >= m_fixedTimeStep)
-		{
-			for (auto& r : m_ragdolls)
-			{
-				r->SolveOneIteration(m_fixedTimeStep);
-			}
+		DebuggerPrintf("Step %i checksum %016llX\n", m_simulationStep, (unsigned long long)m_stepChecksum);
+	}
+}
 
-			m_octree->Update();
-			m_timeDebt -= m_fixedTimeStep;
+void Game::SaveWorldState(std::vector<uint8_t>& out_state)
+{
+	SyncSimulationStep();
+
+	out_state.clear();
+	BufferWriter writer(out_state);
+	writer.AppendUint32(WORLD_STATE_VERSION);
+	writer.AppendInt32((int)m_currentState);
+	writer.AppendInt32(m_simulationStep);
+	writer.AppendFloat(m_timeDebt);
+	writer.AppendUint64(m_stepChecksum);
+	writer.AppendUint32(g_theRNG->m_seed);
+	writer.AppendInt32(g_theRNG->m_position);
+
+	writer.AppendUint32((unsigned int)m_ragdolls.size());
+	for (auto& ragdoll : m_ragdolls)
+	{
+		ragdoll->AppendState(writer);
+	}
+}
+
+bool Game::RestoreWorldState(std::vector<uint8_t> const& state)
+{
+	if (state.empty()) return false;
+
+	SyncSimulationStep();
+
+	BufferParser parser(state);
+	if (parser.ParseUint32() != WORLD_STATE_VERSION) return false;
+	if (parser.ParseInt32() != (int)m_currentState) return false;
+
+	int simulationStep = parser.ParseInt32();
+	float timeDebt = parser.ParseFloat();
+	uint64_t stepChecksum = parser.ParseUint64();
+	unsigned int rngSeed = parser.ParseUint32();
+	int rngPosition = parser.ParseInt32();
+
+	// Nodes leave m_allObjects before any ragdoll that owns them can be deleted below
+	m_allObjects.erase(std::remove_if(m_allObjects.begin(), m_allObjects.end(), [](GameObject* obj) { return obj->m_isNode; }), m_allObjects.end());
+
+	unsigned int numRagdolls = parser.ParseUint32();
+	for (unsigned int i = 0; i < numRagdolls; i++)
+	{
+		size_t start = parser.GetCurReadPosition();
+		if (i < m_ragdolls.size() && m_ragdolls[i]->ParseState(parser)) continue;
+
+		// Another archetype, or a constraint that broke after the save
+		parser.SetCurReadPosition(start);
+		Ragdoll* ragdoll = Ragdoll::CreateFromState(this, parser);
+		if (i < m_ragdolls.size())
+		{
+			delete m_ragdolls[i];
+			m_ragdolls[i] = ragdoll;
 		}
+		else
+		{
+			m_ragdolls.push_back(ragdoll);
+		}
+	}
+	while (m_ragdolls.size() > numRagdolls)
+	{
+		delete m_ragdolls.back();
+		m_ragdolls.pop_back();
+	}
 
-		return;
+	// Every node moved, so the tree is rebuilt from scratch in spawn order
+	for (auto& ragdoll : m_ragdolls)
+	{
+		for (auto& n : ragdoll->GetNodeList())
+		{
+			m_allObjects.push_back(n);
+		}
 	}
+	delete m_octree;
+	Init_Octree();
 
-	//-------------------------------------------------------------
-	// Multi-threaded 
+	m_ragdollRaycastResult = RaycastRagdollResult3D();
+	m_simulationStep = simulationStep;
+	m_timeDebt = timeDebt;
+	m_stepChecksum = stepChecksum;
+	g_theRNG->m_seed = rngSeed;
+	g_theRNG->m_position = rngPosition;
+	return true;
+}
 
-	for (size_t i = 0; i < iterations; i++)
+// FNV-1a over the exact bits of every node's state, in spawn order
+uint64_t Game::ComputeSimulationChecksum() const
+{
+	uint64_t hash = 14695981039346656037ull;
+	auto hashBytes = [&hash](void const* data, size_t size)
 	{
-		for (auto& ragdoll : m_ragdolls)
+		unsigned char const* bytes = (unsigned char const*)data;
+		for (size_t i = 0; i < size; i++)
 		{
-			if (ragdoll && !ragdoll->m_isDead)
-			{
-				// Create job for this ragdoll with fixed timesteps
-				RagdollPhysicsJob* job = new RagdollPhysicsJob(ragdoll, m_fixedTimeStep);
-				g_theJobSystem->QueueJob(job);
-			}
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
 		}
+	};
+	auto hashVec3 = [&hashBytes](DoubleVec3 const& v)
+	{
+		hashBytes(&v.x, sizeof(double));
+		hashBytes(&v.y, sizeof(double));
+		hashBytes(&v.z, sizeof(double));
+	};
 
-		while (g_theJobSystem->GetNumCompletedJobs() > 0)
+	for (auto& ragdoll : m_ragdolls)
+	{
+		if (!ragdoll) continue;
+
+		hashBytes(&ragdoll->m_isDead, sizeof(bool));
+		for (auto& n : ragdoll->GetNodeList())
 		{
-			Job* job = g_theJobSystem->RetrieveJob();
-			delete job;
+			hashVec3(n->m_position);
+			hashVec3(n->m_velocity);
+			hashVec3(n->m_angularVelocity);
+			hashBytes(&n->m_orientation.i, sizeof(double));
+			hashBytes(&n->m_orientation.j, sizeof(double));
+			hashBytes(&n->m_orientation.k, sizeof(double));
+			hashBytes(&n->m_orientation.w, sizeof(double));
 		}
-
-		m_octree->Update();
 	}
-
+	return hash;
 }
 
 void Game::IMGUI_UPDATE()
@@ -835,6 +1103,20 @@ void Game::IMGUI_UPDATE()
 		constraintNum += (int)ragdoll->GetConstraints().size();
 	}
 	ImGui::Text("Total Constraints: %i", constraintNum);
+	if (DEBUG_deterministic)
+	{
+		ImGui::Text("Step %i Checksum: %016llX", m_simulationStep, (unsigned long long)m_stepChecksum);
+	}
+	ImGui::Button("Save World State", ImVec2(150, 20)); ImGui::SameLine();
+	if (ImGui::IsItemClicked(0))
+	{
+		SaveWorldState(m_savedWorldState);
+	}
+	ImGui::Button("Restore World State", ImVec2(150, 20));
+	if (ImGui::IsItemClicked(0))
+	{
+		RestoreWorldState(m_savedWorldState);
+	}
 
 	ImGui::Spacing();
 	//if (DEBUG_usingMultithreading)
@@ -1317,6 +1599,27 @@ void Game::IMGUI_UPDATE()
 	}
 	ImGui::PopStyleColor(1);
 
+	if (DEBUG_ragdollSelfCollision)
+	{
+		ImGui::PushStyleColor(ImGuiCol_Button, activeColor);
+	}
+	else
+	{
+		ImGui::PushStyleColor(ImGuiCol_Button, inactiveColor);
+	}
+
+	ImGui::Button("Ragdoll Self Collision", ImVec2(250, 30));
+	if (ImGui::IsItemClicked(0))
+	{
+		DEBUG_ragdollSelfCollision = !DEBUG_ragdollSelfCollision;
+
+		for (auto& r : m_ragdolls)
+		{
+			r->m_selfCollision = DEBUG_ragdollSelfCollision;
+		}
+	}
+	ImGui::PopStyleColor(1);
+
 
 	ImGui::SeparatorText("Other Configurations");
 	if (m_currentState == GameState::FEATURE_MODE)
@@ -1436,6 +1739,10 @@ void Game::IMGUI_UPDATE()
 		ImGui::Spacing();
 		if (ImGui::CollapsingHeader("Dead State"))
 		{
+			double totalEnergy = g_theJobSystem->ParallelReduce(0, (int)m_ragdolls.size(), 0, 0.0,
+				[this](int i) { return m_ragdolls[i]->GetEnergy(); },
+				[](double a, double b) { return a + b; });
+			ImGui::Text("Total Ragdoll Energy: %.2f", totalEnergy);
 			for (int i = 0; i < m_ragdolls.size(); i++)
 			{
 				std::string result = (m_ragdolls[i]->m_isDead) ? "true" : "false";
@@ -1445,6 +1752,90 @@ void Game::IMGUI_UPDATE()
 			}
 		}
 
+		ImGui::Spacing();
+		if (ImGui::CollapsingHeader("Collision Stats") && m_octree)
+		{
+			OctreeStats const& stats = m_octree->GetStats();
+			ImGui::Text("Candidate Pairs: %i", stats.m_candidatePairs);
+			ImGui::Text("Filtered By Mask: %i", stats.m_pairsFilteredByMask);
+			ImGui::Text("Rejected By AABB: %i", stats.m_pairsRejectedByAABB);
+			ImGui::Text("Narrowphase Tests: %i", stats.GetNumNarrowphaseTests());
+			for (int a = 0; a < NUM_COLLISION_SHAPES; a++)
+			{
+				for (int b = 0; b < NUM_COLLISION_SHAPES; b++)
+				{
+					if (stats.m_narrowphaseTests[a][b] == 0) continue;
+					ImGui::Text("    %s vs %s: %i", GetCollisionShapeName((CollisionShape)a), GetCollisionShapeName((CollisionShape)b), stats.m_narrowphaseTests[a][b]);
+				}
+			}
+			ImGui::Text("Contacts: %i", stats.m_contacts);
+			ImGui::Text("Contact Islands: %i (Asleep: %i, Largest: %i records)", stats.m_numIslands, stats.m_sleepingIslands, stats.m_largestIsland);
+			ImGui::Text("Octree Nodes: %i (Leaves: %i)", stats.m_numNodes, stats.m_numLeaves);
+			ImGui::Text("Octree Depth: %i", stats.m_treeDepth);
+			ImGui::Text("Max Objects Per Leaf: %i", stats.m_maxObjectsPerLeaf);
+			ImGui::Text("Re-insertions: %i (Node Changes: %i)", stats.m_reinsertions, stats.m_nodeChanges);
+		}
+
+		ImGui::Spacing();
+		JobSystemStats const& jobStats = g_theJobSystem->GetFrameStats();
+		m_jobUtilizationHistory[m_jobUtilizationIndex] = (float)jobStats.GetUtilization() * 100.0f;
+		m_jobUtilizationIndex = (m_jobUtilizationIndex + 1) % JOB_UTILIZATION_HISTORY;
+		if (ImGui::CollapsingHeader("Job System Stats"))
+		{
+			JobThreadStats total = jobStats.GetTotal();
+			ImGui::Text("Worker Utilization: %.1f%%", jobStats.GetUtilization() * 100.0);
+			ImGui::PlotLines("##JobUtilization", m_jobUtilizationHistory, JOB_UTILIZATION_HISTORY, m_jobUtilizationIndex, nullptr, 0.0f, 100.0f, ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+			ImGui::Text("Jobs Executed: %llu (Main Thread Helped: %llu)", (unsigned long long)total.m_jobsExecuted, (unsigned long long)jobStats.m_helpers.m_jobsExecuted);
+			ImGui::Text("Steals: %llu / %llu attempts", (unsigned long long)total.m_steals, (unsigned long long)total.m_stealAttempts);
+			ImGui::Text("Parks: %llu", (unsigned long long)total.m_parks);
+			ImGui::Text("Avg Queue Latency: %.1f us", total.GetAverageQueueLatencyMicroseconds());
+
+			float latencyBuckets[JOB_LATENCY_BUCKETS];
+			for (int i = 0; i < JOB_LATENCY_BUCKETS; i++)
+			{
+				latencyBuckets[i] = (float)total.m_queueLatencyHistogram[i];
+			}
+			ImGui::Text("Queue Latency Histogram (bucket i < 2^i us)");
+			ImGui::PlotHistogram("##JobLatency", latencyBuckets, JOB_LATENCY_BUCKETS, 0, nullptr, 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+			for (int i = 0; i < (int)jobStats.m_workers.size(); i++)
+			{
+				JobThreadStats const& worker = jobStats.m_workers[i];
+				ImGui::Text("Worker [%i] Busy: %.1f%%, Jobs: %llu, Steals: %llu", i, jobStats.GetWorkerUtilization(i) * 100.0, (unsigned long long)worker.m_jobsExecuted, (unsigned long long)worker.m_steals);
+			}
+		}
+
+		ImGui::Spacing();
+		if (ImGui::CollapsingHeader("Replay"))
+		{
+			if (m_replayRecorder.IsRecording())
+			{
+				ImGui::Text("Recording: %i frames, %.1f KB", m_replayRecorder.GetNumFrames(), m_replayRecorder.GetNumBytesRecorded() / 1024.0);
+			}
+			if (m_replayPlayer.IsLoaded())
+			{
+				int frame = m_replayPlayer.GetCurrentFrame();
+				if (ImGui::SliderInt("Frame", &frame, 0, m_replayPlayer.GetNumFrames() - 1))
+				{
+					m_replayPlayer.SeekToFrame(frame);
+					m_replayTime = frame * m_replayPlayer.GetStepSeconds();
+				}
+				ImGui::Text("Step %i, %i events", m_replayPlayer.GetCurrentStep(), (int)m_replayPlayer.GetCurrentEvents().size());
+				ImGui::Button(m_isReplayPlaying ? "Pause" : "Play", ImVec2(70, 20)); ImGui::SameLine();
+				if (ImGui::IsItemClicked(0))
+				{
+					m_isReplayPlaying = !m_isReplayPlaying;
+				}
+				ImGui::Button("Close", ImVec2(70, 20));
+				if (ImGui::IsItemClicked(0))
+				{
+					m_replayPlayer.Unload();
+					m_isReplayPlaying = false;
+				}
+			}
+			ImGui::Text("\"replay record=<file>\", \"replay stop=true\", \"replay play=<file>\"");
+		}
+
 		ImGui::Spacing();
 		if (ImGui::CollapsingHeader("Octree Data"))
 		{
@@ -1453,7 +1844,7 @@ void Game::IMGUI_UPDATE()
 				if (allObject->m_isNode)
 				{
 					int layer = -1;
-					if (allObject->m_currentOctree) layer = allObject->m_currentOctree->m_layer;
+					if (allObject->m_octreeNode != -1) layer = m_octree->m_nodes[allObject->m_octreeNode].m_layer;
 					ImGui::Text("Nodes [%s] Octree Layer: %i", ((Node*)allObject)->m_name.c_str(), layer);
 				}
 
@@ -1847,8 +2238,10 @@ void Game::SpawnRagdoll(Mat44 transform, Rgba8 color, Vec3 initialVelocity)
 
 	Ragdoll* newR = new Ragdoll(this, transform, DEBUG_ragdoll_deadTimer, config, m_ragdollDebugType, color, Rgba8::GetDarkerColor(color, 0.3f));
 	newR->m_deadTimer = DEBUG_ragdoll_deadTimer;
+	newR->m_spawnID = m_nextSpawnID++;
 	newR->m_isBreakable = DEBUG_breakable;
 	newR->DEBUG_solveConstraintWithFixedIteration = DEBUG_solveConstraintWithFixedIteration;
+	newR->m_selfCollision = DEBUG_ragdollSelfCollision;
 
 	newR->ApplyGlobalImpulseOnRoot(initialVelocity);
 	newR->DEBUG_maxVelocity = DEBUG_maxVelocity;
@@ -1856,6 +2249,7 @@ void Game::SpawnRagdoll(Mat44 transform, Rgba8 color, Vec3 initialVelocity)
 	newR->DEBUG_angleFixRate = DEBUG_angleFixRate;
 
 	m_ragdolls.push_back(newR);
+	m_replayRecorder.RecordEvent({ ReplayEventType::SPAWN, newR->m_spawnID, transform.GetTranslation3D() });
 
 	if (m_octree)
 	{
@@ -1878,6 +2272,8 @@ void Game::SpawnRagdoll(Mat44 transform, Rgba8 color, Vec3 initialVelocity)
 
 void Game::DeleteRagdoll(Ragdoll* r)
 {
+	m_replayRecorder.RecordEvent({ ReplayEventType::DESPAWN, r->m_spawnID, Vec3() });
+
 	for (size_t i = 0; i < r->GetNodeList().size(); i++)
 	{
 		auto findNode = std::find(m_allObjects.begin(), m_allObjects.end(), r->GetNodeList()[i]);
@@ -1892,6 +2288,14 @@ void Game::DeleteRagdoll(Ragdoll* r)
 	Init_Octree();
 }
 
+void Game::PushRagdoll(Ragdoll* r, DoubleVec3 acceleration)
+{
+	r->ApplyGlobalAcceleration(acceleration);
+	r->m_deadTimer = DEBUG_ragdoll_deadTimer;
+	r->m_timeSinceSpawn = 0.f;
+	m_replayRecorder.RecordEvent({ ReplayEventType::PUSH, r->m_spawnID, Vec3((float)acceleration.x, (float)acceleration.y, (float)acceleration.z) });
+}
+
 void Game::Menu_Init()
 {
 	m_menuCanvas = new Canvas(g_UI, m_screenCamera);
@@ -1934,32 +2338,580 @@ void Game::Menu_Init()
 
 void Game::RaycastVsRagdolls()
 {
-	if (m_ragdolls.empty()) return;
+	if (m_ragdolls.empty() || !m_octree) return;
 	IntVec2 clientDim = Window::GetMainWindowInstance()->GetClientDimensions();
 	Vec2 mousePos = g_theInput->GetCursorNormalizedPosition() * Vec2((float)clientDim.x, (float)clientDim.y);
+
+	Vec3 rayStart;
+	Vec3 rayFwd;
+	MouseToRaycast(m_player->GetCamera(), mousePos, rayStart, rayFwd);
+	OctreeRaycastResult hit = m_octree->Raycast(rayStart, rayFwd, FLT_MAX, COLLISION_CATEGORY_RAGDOLL);
+
 	RaycastRagdollResult3D closestRagdollNodeHit;
+	static_cast<RaycastResult3D&>(closestRagdollNodeHit) = hit;
 
-	for (auto& ragdoll : m_ragdolls)
+	if (hit.m_didImpact && hit.m_hitObject->m_isNode)
 	{
-		RaycastRagdollResult3D result = MouseRaycastVsRagdollNode(m_player->GetCamera(), mousePos, ragdoll);
-		if (result.m_didImpact)
+		Node* node = (Node*)hit.m_hitObject;
+		closestRagdollNodeHit.m_hitNode = node;
+		for (Constraint* c : node->m_ragdoll->GetConstraints())
 		{
-			if (!closestRagdollNodeHit.m_didImpact)
+			if (c->nA == node || c->nB == node)
 			{
-				closestRagdollNodeHit = result;
+				closestRagdollNodeHit.m_hitConstraints.push_back(c);
+			}
+		}
+	}
+
+	m_ragdollRaycastResult = closestRagdollNodeHit;
+}
+
+// "collisionstats" prints the last step's octree counters; "collisionstats log=true" prints them every step
+bool Game::Event_CollisionStats(EventArgs& args)
+{
+	g_theGame->SyncSimulationStep();
+
+	if (args.IsKeyNameValid("log"))
+	{
+		g_theGame->DEBUG_logCollisionStats = args.GetValue("log", false);
+	}
+
+	if (!g_theGame->m_octree)
+	{
+		g_theDevConsole->AddLine(DevConsole::WARNING, "No octree to report on");
+		return true;
+	}
+
+	std::string text = g_theGame->m_octree->GetStats().ToString();
+	DebuggerPrintf("%s", text.c_str());
+	for (std::string const& line : SplitStringOnDelimiter(text, '\n', true))
+	{
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, line);
+	}
+	return true;
+}
+
+bool Game::Event_Deterministic(EventArgs& args)
+{
+	g_theGame->SyncSimulationStep();
+
+	if (args.IsKeyNameValid("on"))
+	{
+		g_theGame->DEBUG_deterministic = args.GetValue("on", false);
+	}
+	if (args.IsKeyNameValid("log"))
+	{
+		g_theGame->DEBUG_logStepChecksums = args.GetValue("log", false);
+	}
+
+	std::string status = Stringf("Deterministic: %s, step %i checksum %016llX", g_theGame->DEBUG_deterministic ? "on" : "off", g_theGame->m_simulationStep, (unsigned long long)g_theGame->m_stepChecksum);
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, status);
+	return true;
+}
+
+// "worldstate save=true" keeps the current world state, "worldstate restore=true" goes back to it
+bool Game::Event_WorldState(EventArgs& args)
+{
+	if (args.GetValue("save", false))
+	{
+		g_theGame->SaveWorldState(g_theGame->m_savedWorldState);
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Saved step %i, %u bytes", g_theGame->m_simulationStep, (unsigned int)g_theGame->m_savedWorldState.size()));
+	}
+	if (args.GetValue("restore", false))
+	{
+		if (g_theGame->RestoreWorldState(g_theGame->m_savedWorldState))
+		{
+			g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Restored step %i", g_theGame->m_simulationStep));
+		}
+		else
+		{
+			g_theDevConsole->AddLine(DevConsole::WARNING, "No saved world state for this mode");
+		}
+	}
+	return true;
+}
+
+// "replay record=<file>" records every fixed step until "replay stop=true"; "replay play=<file>" shows a
+// recording instead of the live world, "replay frame=<n>" scrubs it and "replay close=true" goes back
+bool Game::Event_Replay(EventArgs& args)
+{
+	Game* game = g_theGame;
+	game->SyncSimulationStep();
+
+	if (args.IsKeyNameValid("record"))
+	{
+		std::string filePath = args.GetValue("record", "Replay.rgrp");
+		if (game->m_replayRecorder.Start(filePath, game->m_fixedTimeStep))
+		{
+			g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Recording to %s", filePath.c_str()));
+		}
+		else
+		{
+			g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("Cannot write %s", filePath.c_str()));
+		}
+	}
+	if (args.GetValue("stop", false))
+	{
+		game->m_replayRecorder.Stop();
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Recorded %i frames, %u bytes", game->m_replayRecorder.GetNumFrames(), (unsigned int)game->m_replayRecorder.GetNumBytesRecorded()));
+	}
+	if (args.IsKeyNameValid("play"))
+	{
+		std::string filePath = args.GetValue("play", "Replay.rgrp");
+		game->m_isReplayPlaying = game->m_replayPlayer.Load(game, filePath);
+		game->m_replayTime = 0.f;
+		if (!game->m_isReplayPlaying)
+		{
+			g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("%s is not a replay", filePath.c_str()));
+		}
+	}
+	if (args.IsKeyNameValid("frame"))
+	{
+		int frame = args.GetValue("frame", 0);
+		game->m_replayPlayer.SeekToFrame(frame);
+		game->m_replayTime = frame * game->m_replayPlayer.GetStepSeconds();
+		game->m_isReplayPlaying = false;
+	}
+	if (args.GetValue("close", false))
+	{
+		game->m_replayPlayer.Unload();
+		game->m_isReplayPlaying = false;
+	}
+	return true;
+}
+
+struct SolverNodeState
+{
+	DoubleVec3 m_position;
+	DoubleVec3 m_velocity;
+	DoubleQuaternion m_orientation;
+	DoubleVec3 m_angularVelocity;
+};
+
+// "solverbench iterations=<n>" runs the constraint solver n times over the current world and puts it back.
+// The checksum after the run must match between the scalar and ENGINE_DOUBLE_MATH_AVX builds.
+bool Game::Event_SolverBench(EventArgs& args)
+{
+	Game* game = g_theGame;
+	game->SyncSimulationStep();
+
+	if (game->m_ragdolls.empty())
+	{
+		g_theDevConsole->AddLine(DevConsole::WARNING, "No ragdolls to solve");
+		return true;
+	}
+
+	int iterations = args.GetValue("iterations", 200);
+
+	// The solver only moves nodes, so their transforms and velocities are all that needs putting back
+	std::vector<Node*> nodes;
+	int numConstraints = 0;
+	for (Ragdoll* ragdoll : game->m_ragdolls)
+	{
+		std::vector<Node*> ragdollNodes = ragdoll->GetNodeList();
+		nodes.insert(nodes.end(), ragdollNodes.begin(), ragdollNodes.end());
+		numConstraints += (int)ragdoll->GetConstraints().size();
+	}
+	std::vector<SolverNodeState> savedNodes;
+	savedNodes.reserve(nodes.size());
+	for (Node* node : nodes)
+	{
+		savedNodes.push_back({ node->m_position, node->m_velocity, node->m_orientation, node->m_angularVelocity });
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (Ragdoll* ragdoll : game->m_ragdolls)
+		{
+			ragdoll->ApplyConstraints(game->m_fixedTimeStep, game->DEBUG_constraintNumLoop, ragdoll->DEBUG_solveConstraintWithFixedIteration);
+		}
+	}
+	double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+	uint64_t checksum = game->ComputeSimulationChecksum();
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		nodes[i]->m_position = savedNodes[i].m_position;
+		nodes[i]->m_velocity = savedNodes[i].m_velocity;
+		nodes[i]->m_orientation = savedNodes[i].m_orientation;
+		nodes[i]->m_angularVelocity = savedNodes[i].m_angularVelocity;
+	}
+
+#if defined(ENGINE_DOUBLE_MATH_AVX)
+	char const* backendName = "AVX";
+#else
+	char const* backendName = "scalar";
+#endif
+	double microsecondsPerIteration = elapsedSeconds * 1000000.0 / (double)(iterations > 0 ? iterations : 1);
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Solver (%s): %i ragdolls, %i constraints, %.2f us per iteration, checksum %016llX",
+		backendName, (int)game->m_ragdolls.size(), numConstraints, microsecondsPerIteration, (unsigned long long)checksum));
+	return true;
+}
+
+static DoubleCapsule3 GetNodeCapsule(Node const* node)
+{
+	double axisHalfLength = node->GetHalfLength() - node->m_radius;
+	DoubleVec3 axisNormalized = node->GetAxis().GetNormalized();
+	return DoubleCapsule3(node->m_position - axisNormalized * axisHalfLength, node->m_position + axisNormalized * axisHalfLength, node->m_radius);
+}
+
+static int CountDifferentInfos(std::vector<CollisionInfo> const& infosA, std::vector<CollisionInfo> const& infosB)
+{
+	int numDifferent = 0;
+	for (size_t i = 0; i < infosA.size(); i++)
+	{
+		if (infosA[i].isColliding != infosB[i].isColliding || infosA[i].contactPoint != infosB[i].contactPoint || infosA[i].normal != infosB[i].normal)
+		{
+			numDifferent++;
+		}
+	}
+	return numDifferent;
+}
+
+// "narrowphasebench iterations=<n>" gathers the node pairs and capsule-vs-OBB pairs whose bounds overlap right now,
+// then times their narrowphase one call per pair against the batched MathUtils kernels and checks both agree
+bool Game::Event_NarrowphaseBench(EventArgs& args)
+{
+	Game* game = g_theGame;
+	game->SyncSimulationStep();
+
+	int iterations = args.GetValue("iterations", 100);
+	if (iterations < 1) iterations = 1;
+
+	std::vector<Node*> nodes;
+	for (Ragdoll* ragdoll : game->m_ragdolls)
+	{
+		std::vector<Node*> ragdollNodes = ragdoll->GetNodeList();
+		nodes.insert(nodes.end(), ragdollNodes.begin(), ragdollNodes.end());
+	}
+
+	SpherePairBatch spherePairs;
+	CapsuleSpherePairBatch capsuleSpherePairs;
+	CapsulePairBatch capsulePairs;
+	CapsuleOBBPairBatch capsuleOBBPairs;
+	for (size_t a = 0; a < nodes.size(); a++)
+	{
+		Node* nodeA = nodes[a];
+		for (size_t b = a + 1; b < nodes.size(); b++)
+		{
+			Node* nodeB = nodes[b];
+			if (nodeA->m_ragdoll == nodeB->m_ragdoll) continue;
+			if (!DoAABBsOverlap3D_Double(nodeA->GetBoundingBox(), nodeB->GetBoundingBox())) continue;
+
+			if (nodeA->IsSphere() && nodeB->IsSphere())
+			{
+				spherePairs.AddPair(nodeA->m_position, nodeA->m_radius, nodeB->m_position, nodeB->m_radius);
+			}
+			else if (nodeA->IsSphere())
+			{
+				capsuleSpherePairs.AddPair(GetNodeCapsule(nodeB), nodeA->m_position, nodeA->m_radius);
+			}
+			else if (nodeB->IsSphere())
+			{
+				capsuleSpherePairs.AddPair(GetNodeCapsule(nodeA), nodeB->m_position, nodeB->m_radius);
 			}
 			else
 			{
-				if (result.m_impactDist < closestRagdollNodeHit.m_impactDist)
-				{
-					closestRagdollNodeHit = result;
-				}
+				capsulePairs.AddPair(GetNodeCapsule(nodeA), GetNodeCapsule(nodeB));
 			}
 		}
 
+		if (nodeA->IsSphere()) continue;
+		for (GameObject* object : game->m_fixedObjects)
+		{
+			if (object->m_collisionShape != COLLISION_SHAPE_OBB) continue;
+			if (!DoAABBsOverlap3D_Double(nodeA->GetBoundingBox(), object->GetBoundingBox())) continue;
+			capsuleOBBPairs.AddPair(GetNodeCapsule(nodeA), ((Object_OBB*)object)->m_obb);
+		}
 	}
 
-	m_ragdollRaycastResult = closestRagdollNodeHit;
+	std::vector<CollisionInfo> singleInfos[4];
+	singleInfos[0].resize(spherePairs.GetNumPairs());
+	singleInfos[1].resize(capsuleSpherePairs.GetNumPairs());
+	singleInfos[2].resize(capsulePairs.GetNumPairs());
+	singleInfos[3].resize(capsuleOBBPairs.GetNumPairs());
+	std::vector<CollisionInfo> batchInfos[4];
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (size_t i = 0; i < spherePairs.GetNumPairs(); i++)
+		{
+			singleInfos[0][i] = DoSpheresOverlap3D_Info(spherePairs.m_centersA.Get(i), spherePairs.m_radiiA[i], spherePairs.m_centersB.Get(i), spherePairs.m_radiiB[i]);
+		}
+		for (size_t i = 0; i < capsuleSpherePairs.GetNumPairs(); i++)
+		{
+			DoubleCapsule3 capsule(capsuleSpherePairs.m_capsuleStarts.Get(i), capsuleSpherePairs.m_capsuleEnds.Get(i), capsuleSpherePairs.m_capsuleRadii[i]);
+			singleInfos[1][i] = DoCapsuleAndSphereOverlap3D_Info(capsule, capsuleSpherePairs.m_sphereCenters.Get(i), capsuleSpherePairs.m_sphereRadii[i]);
+		}
+		for (size_t i = 0; i < capsulePairs.GetNumPairs(); i++)
+		{
+			DoubleCapsule3 capsuleA(capsulePairs.m_startsA.Get(i), capsulePairs.m_endsA.Get(i), capsulePairs.m_radiiA[i]);
+			DoubleCapsule3 capsuleB(capsulePairs.m_startsB.Get(i), capsulePairs.m_endsB.Get(i), capsulePairs.m_radiiB[i]);
+			singleInfos[2][i] = DoCapsulesOverlap3D_Info(capsuleA, capsuleB);
+		}
+		for (size_t i = 0; i < capsuleOBBPairs.GetNumPairs(); i++)
+		{
+			DoubleCapsule3 capsule(capsuleOBBPairs.m_capsuleStarts.Get(i), capsuleOBBPairs.m_capsuleEnds.Get(i), capsuleOBBPairs.m_capsuleRadii[i]);
+			DoubleOBB3 box;
+			box.m_center = capsuleOBBPairs.m_boxCenters.Get(i);
+			box.m_iBasisNormal = capsuleOBBPairs.m_boxIBasisNormals.Get(i);
+			box.m_jBasisNormal = capsuleOBBPairs.m_boxJBasisNormals.Get(i);
+			box.m_halfDimensions = capsuleOBBPairs.m_boxHalfDimensions.Get(i);
+			singleInfos[3][i] = DoCapsuleAndOBBOverlap3D_Info(capsule, box);
+		}
+	}
+	double singleSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int iteration = 0; iteration < iterations; ++iteration)
+	{
+		DoSpheresOverlap3D_Info(spherePairs, batchInfos[0]);
+		DoCapsuleAndSphereOverlap3D_Info(capsuleSpherePairs, batchInfos[1]);
+		DoCapsulesOverlap3D_Info(capsulePairs, batchInfos[2]);
+		DoCapsuleAndOBBOverlap3D_Info(capsuleOBBPairs, batchInfos[3]);
+	}
+	double batchSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int numDifferent = 0;
+	for (int kind = 0; kind < 4; kind++)
+	{
+		numDifferent += CountDifferentInfos(singleInfos[kind], batchInfos[kind]);
+	}
+
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Pairs: %i sphere, %i capsule-sphere, %i capsule, %i capsule-OBB",
+		(int)spherePairs.GetNumPairs(), (int)capsuleSpherePairs.GetNumPairs(), (int)capsulePairs.GetNumPairs(), (int)capsuleOBBPairs.GetNumPairs()));
+	g_theDevConsole->AddLine(numDifferent == 0 ? DevConsole::INFO_MINOR : DevConsole::WARNING, Stringf("Per pair %.2f us, batched %.2f us per iteration, %i results differ",
+		singleSeconds * 1000000.0 / (double)iterations, batchSeconds * 1000000.0 / (double)iterations, numDifferent));
+	return true;
+}
+
+// Copies of the node and constraint state Constraint::SolveDistanceAndVelocity reads and writes, in either precision
+template <typename T>
+struct PrecisionBenchNode
+{
+	TVec3<T> m_position;
+	TVec3<T> m_velocity;
+	TVec3<T> m_acceleration;
+	TVec3<T> m_angularVelocity;
+	TQuat<T> m_orientation;
+	TVec3<T> m_capsuleAxis;
+	T m_capsuleHalfAxisLength = 0;
+	T m_radius = 0;
+	T m_invMass = 0;
+	bool m_isSphere = true;
+};
+
+template <typename T>
+struct PrecisionBenchConstraint
+{
+	int m_nodeA = 0;
+	int m_nodeB = 0;
+	TVec3<T> m_rPinA;
+	TVec3<T> m_rPinB;
+	T m_targetDistance = 0;
+};
+
+// SphereNode::GetPointOnBody and CapsuleNode::GetPointOnBody
+template <typename T>
+static TVec3<T> GetBenchPointOnBody(PrecisionBenchNode<T> const& node, TVec3<T> const& pin)
+{
+	TVec3<T> point = node.m_position + node.m_orientation.Rotate(pin);
+	if (node.m_isSphere) return point;
+
+	TVec3<T> axisNormalized = node.m_orientation.Rotate(node.m_capsuleAxis).GetNormalized();
+	TVec3<T> start = node.m_position - axisNormalized * node.m_capsuleHalfAxisLength;
+	TVec3<T> bone = axisNormalized * (node.m_capsuleHalfAxisLength * 2);
+	T boneLengthSquared = bone.GetLengthSquared();
+	T t = boneLengthSquared > T(0) ? PrecisionMath<T>::Clamp((point - start).Dot(bone) / boneLengthSquared, T(0), T(1)) : T(0);
+	TVec3<T> nearestPointOnBone = start + bone * t;
+	TVec3<T> fromNearestToPoint = point - nearestPointOnBone;
+	T length = PrecisionMath<T>::Clamp(fromNearestToPoint.GetLength(), T(0), node.m_radius);
+	return nearestPointOnBone + fromNearestToPoint.GetNormalized() * length;
+}
+
+// Constraint::SolveDistanceAndVelocity line for line. GameObject::GetInverseInertiaTensor is the identity, so it is left out
+template <typename T>
+static void SolveBenchDistanceAndVelocity(PrecisionBenchConstraint<T> const& constraint, std::vector<PrecisionBenchNode<T>>& nodes, T timeStep, T fixRate, T impulseLimit)
+{
+	PrecisionBenchNode<T>& nA = nodes[constraint.m_nodeA];
+	PrecisionBenchNode<T>& nB = nodes[constraint.m_nodeB];
+	TVec3<T> const& rPinA = constraint.m_rPinA;
+	TVec3<T> const& rPinB = constraint.m_rPinB;
+
+	TVec3<T> deltaPos = GetBenchPointOnBody(nB, rPinB) - GetBenchPointOnBody(nA, rPinA);
+	TVec3<T> deltaPosNormal = deltaPos.GetNormalized();
+	T errorDist = constraint.m_targetDistance - deltaPos.GetLength();
+	T sign = errorDist < T(0) ? T(-1) : T(1);
+
+	TVec3<T> deltaPosANormal = nA.m_orientation.GetConjugated().Rotate(deltaPosNormal).GetNormalized();
+	TVec3<T> deltaPosBNormal = nB.m_orientation.GetConjugated().Rotate(deltaPosNormal).GetNormalized();
+	T aDotPos = deltaPosANormal.Dot(rPinA.Cross(deltaPosANormal).Cross(rPinA));
+	T bDotPos = deltaPosBNormal.Dot(rPinB.Cross(deltaPosBNormal).Cross(rPinB));
+	T jPos = T(-1) / (nA.m_invMass + nB.m_invMass + aDotPos + bDotPos);
+
+	bool isFixingPosition = std::abs(errorDist) > T(0.1);
+	if (isFixingPosition)
+	{
+		nA.m_position += deltaPos * (jPos * sign * nA.m_invMass * timeStep * fixRate);
+		nB.m_position -= deltaPos * (jPos * sign * nB.m_invMass * timeStep * fixRate);
+	}
+
+	TVec3<T> crossQuatA = rPinA.Cross(nA.m_orientation.GetConjugated().Rotate(deltaPos * jPos));
+	TQuat<T> deltaQA = TQuat<T>::ComputeQuaternion(nA.m_orientation.Rotate(crossQuatA));
+
+	TVec3<T> pinVelA = nA.m_velocity + nA.m_orientation.Rotate(nA.m_angularVelocity.Cross(rPinA));
+	TVec3<T> pinVelB = nB.m_velocity + nB.m_orientation.Rotate(nB.m_angularVelocity.Cross(rPinB));
+	TVec3<T> deltaVel = pinVelA - pinVelB;
+	TVec3<T> deltaVelNormal = deltaVel.GetNormalized();
+
+	TVec3<T> nDvA = nA.m_orientation.GetConjugated().Rotate(deltaVelNormal);
+	TVec3<T> nDvB = nB.m_orientation.GetConjugated().Rotate(deltaVelNormal);
+	T aDotVel = nDvA.Dot(rPinA.Cross(nDvA).Cross(rPinA));
+	T bDotVel = nDvB.Dot(rPinB.Cross(nDvB).Cross(rPinB));
+	T jVel = T(-1) / (nA.m_invMass + nB.m_invMass + aDotVel + bDotVel);
+
+	TVec3<T> aVelImpulse = deltaVel * (jVel * nA.m_invMass);
+	TVec3<T> bVelImpulse = deltaVel * (jVel * nB.m_invMass);
+	aVelImpulse.UniformClamp(-impulseLimit, impulseLimit);
+	bVelImpulse.UniformClamp(-impulseLimit, impulseLimit);
+	nA.m_velocity += aVelImpulse;
+	nB.m_velocity -= bVelImpulse;
+
+	nA.m_angularVelocity += rPinA.Cross(nA.m_orientation.GetConjugated().Rotate(deltaVel * jVel));
+	nB.m_angularVelocity -= rPinB.Cross(nB.m_orientation.GetConjugated().Rotate(deltaVel * jVel));
+
+	if (isFixingPosition)
+	{
+		nA.m_orientation = deltaQA * nA.m_orientation;
+		nA.m_orientation.Normalize();
+		nB.m_orientation.Normalize();
+	}
+}
+
+// Gravity and the velocity Verlet position update from Ragdoll::SolveOneIteration, then the fixed-iteration distance solve.
+// Angle limits, contacts and resting are left out
+template <typename T>
+static double TimeBenchSteps(std::vector<PrecisionBenchNode<T>>& nodes, std::vector<PrecisionBenchConstraint<T>> const& constraints, VerletConfig const& config,
+	float timeStep, int numConstraintLoops, double fixRate, double impulseLimit, int numSteps)
+{
+	TVec3<T> gravity(config.gravAccel);
+	T dt = (T)timeStep;
+	T friction = (T)config.airFriction;
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int step = 0; step < numSteps; ++step)
+	{
+		for (PrecisionBenchNode<T>& node : nodes)
+		{
+			node.m_position += node.m_velocity * ((T(1) - friction) * dt) + node.m_acceleration * (T(0.5) * dt * dt);
+			node.m_velocity += (node.m_acceleration + gravity) * (T(0.5) * dt);
+			node.m_acceleration = gravity;
+		}
+		for (int loop = 0; loop < numConstraintLoops; ++loop)
+		{
+			for (PrecisionBenchConstraint<T> const& constraint : constraints)
+			{
+				SolveBenchDistanceAndVelocity(constraint, nodes, dt, (T)fixRate, (T)impulseLimit);
+			}
+		}
+	}
+	return GetCurrentTimeSeconds() - startTime;
+}
+
+template <typename T>
+static void CopyBenchState(std::vector<Node*> const& nodes, std::vector<Constraint*> const& constraints, std::vector<Node*> const& constraintNodes,
+	std::vector<PrecisionBenchNode<T>>& out_nodes, std::vector<PrecisionBenchConstraint<T>>& out_constraints)
+{
+	for (Node* node : nodes)
+	{
+		PrecisionBenchNode<T> benchNode;
+		benchNode.m_position = TVec3<T>(node->m_position);
+		benchNode.m_velocity = TVec3<T>(node->m_velocity);
+		benchNode.m_acceleration = TVec3<T>(node->m_acceleration);
+		benchNode.m_angularVelocity = TVec3<T>(node->m_angularVelocity);
+		benchNode.m_orientation = TQuat<T>(node->m_orientation);
+		benchNode.m_radius = (T)node->m_radius;
+		benchNode.m_invMass = (T)node->m_invMass;
+		benchNode.m_isSphere = node->IsSphere();
+		if (!benchNode.m_isSphere)
+		{
+			CapsuleNode const* capsule = (CapsuleNode const*)node;
+			benchNode.m_capsuleAxis = TVec3<T>(capsule->m_capsuleAxis);
+			benchNode.m_capsuleHalfAxisLength = (T)capsule->m_capsuleHalfAxisLength;
+		}
+		out_nodes.push_back(benchNode);
+	}
+	for (size_t i = 0; i < constraints.size(); i++)
+	{
+		PrecisionBenchConstraint<T> benchConstraint;
+		benchConstraint.m_nodeA = (int)(std::find(nodes.begin(), nodes.end(), constraintNodes[2 * i]) - nodes.begin());
+		benchConstraint.m_nodeB = (int)(std::find(nodes.begin(), nodes.end(), constraintNodes[2 * i + 1]) - nodes.begin());
+		benchConstraint.m_rPinA = TVec3<T>(constraints[i]->m_rPinA);
+		benchConstraint.m_rPinB = TVec3<T>(constraints[i]->m_rPinB);
+		benchConstraint.m_targetDistance = (T)constraints[i]->m_targetDistance;
+		out_constraints.push_back(benchConstraint);
+	}
+}
+
+// "precisionbench steps=<n>" copies the first ragdoll's nodes and constraints and runs n fixed steps of gravity plus the distance solve
+// once as TVec3<float>/TQuat<float> and once as TVec3<double>/TQuat<double>. Reports both timings and how far the float nodes
+// ended up from the double ones. The world itself is not touched.
+bool Game::Event_PrecisionBench(EventArgs& args)
+{
+	Game* game = g_theGame;
+	game->SyncSimulationStep();
+
+	int steps = args.GetValue("steps", 60);
+	if (steps < 1) steps = 1;
+
+	if (game->m_ragdolls.empty())
+	{
+		g_theDevConsole->AddLine(DevConsole::WARNING, "No ragdolls to solve");
+		return true;
+	}
+
+	// One ragdoll, since they do not interact without contacts and the drift of one is the drift of all
+	Ragdoll* ragdoll = game->m_ragdolls.front();
+	std::vector<Node*> nodes = ragdoll->GetNodeList();
+	std::vector<Constraint*> constraints;
+	std::vector<Node*> constraintNodes;
+	for (Constraint* constraint : ragdoll->GetConstraints())
+	{
+		if (std::find(nodes.begin(), nodes.end(), constraint->nA) == nodes.end()) continue;
+		if (std::find(nodes.begin(), nodes.end(), constraint->nB) == nodes.end()) continue;
+
+		constraints.push_back(constraint);
+		constraintNodes.push_back(constraint->nA);
+		constraintNodes.push_back(constraint->nB);
+	}
+
+	std::vector<PrecisionBenchNode<float>> floatNodes;
+	std::vector<PrecisionBenchConstraint<float>> floatConstraints;
+	CopyBenchState(nodes, constraints, constraintNodes, floatNodes, floatConstraints);
+	std::vector<PrecisionBenchNode<double>> doubleNodes;
+	std::vector<PrecisionBenchConstraint<double>> doubleConstraints;
+	CopyBenchState(nodes, constraints, constraintNodes, doubleNodes, doubleConstraints);
+
+	int numLoops = (int)game->DEBUG_constraintNumLoop;
+	double floatSeconds = TimeBenchSteps(floatNodes, floatConstraints, ragdoll->m_config, game->m_fixedTimeStep, numLoops, ragdoll->DEBUG_posFixRate, game->DEBUG_deltaImpulseLimit, steps);
+	double doubleSeconds = TimeBenchSteps(doubleNodes, doubleConstraints, ragdoll->m_config, game->m_fixedTimeStep, numLoops, ragdoll->DEBUG_posFixRate, game->DEBUG_deltaImpulseLimit, steps);
+
+	double maxPositionDrift = 0.0;
+	double maxOrientationDrift = 0.0;
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		maxPositionDrift = std::max(maxPositionDrift, (DoubleVec3(floatNodes[i].m_position) - doubleNodes[i].m_position).GetLength());
+		double orientationDot = std::min(std::abs(DoubleQuaternion(floatNodes[i].m_orientation).Dot(doubleNodes[i].m_orientation)), 1.0);
+		maxOrientationDrift = std::max(maxOrientationDrift, 2.0 * acos(orientationDot));
+	}
+
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Distance solve: %i nodes, %i constraints, float %.2f us, double %.2f us per step",
+		(int)nodes.size(), (int)constraints.size(), floatSeconds * 1000000.0 / (double)steps, doubleSeconds * 1000000.0 / (double)steps));
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("After %i steps float is off by up to %.3g in position and %.3g radians in orientation",
+		steps, maxPositionDrift, maxOrientationDrift));
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------
@@ -2012,6 +2964,7 @@ void Game::UpdateAllCurrentRagdolls()
 		r->DEBUG_posFixRate = DEBUG_posFixRate;
 		r->DEBUG_maxVelocity = DEBUG_maxVelocity;
 		r->m_isBreakable = DEBUG_breakable;
+		r->m_selfCollision = DEBUG_ragdollSelfCollision;
 		r->m_deadTimer = DEBUG_ragdoll_deadTimer;
 		if (DEBUG_allRagdollLiveForever)
 		{
@@ -2032,6 +2985,8 @@ Object_AABB::Object_AABB(Game* game, DoubleAABB3 aabb)
 	:GameObject(game), m_aabb(aabb)
 {
 	m_isFixed = true;
+	m_collisionCategory = COLLISION_CATEGORY_STATIC;
+	m_collisionShape = COLLISION_SHAPE_AABB;
 
 	AddVertsForAABB3D(m_vertexes, m_indexes, aabb, Rgba8::COLOR_WHITE);
 	CreateBuffer(g_theRenderer);
@@ -2072,6 +3027,11 @@ DoubleAABB3 Object_AABB::GetBoundingBox() const
 	return m_aabb;
 }
 
+RaycastResult3D Object_AABB::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	return RaycastVsAABB3D(startPos, fwdNormal, maxDist, m_aabb);
+}
+
 bool Object_AABB::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (!node->m_isNode) return false;
@@ -2084,6 +3044,8 @@ Object_OBB::Object_OBB(Game* game, DoubleOBB3 obb)
 	:GameObject(game), m_obb(obb)
 {
 	m_isFixed = true;
+	m_collisionCategory = COLLISION_CATEGORY_STATIC;
+	m_collisionShape = COLLISION_SHAPE_OBB;
 	AddVertsForOBB3D(m_vertexes, m_indexes, obb, Rgba8::COLOR_WHITE);
 	CreateBuffer(g_theRenderer);
 
@@ -2122,6 +3084,11 @@ DoubleAABB3 Object_OBB::GetBoundingBox() const
 	return m_obb.GetBoundingBox();
 }
 
+RaycastResult3D Object_OBB::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	return RaycastVsOBB3D(startPos, fwdNormal, maxDist, m_obb);
+}
+
 bool Object_OBB::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (!node->m_isNode) return false;
@@ -2134,6 +3101,8 @@ Object_Sphere::Object_Sphere(Game* game, DoubleVec3 center, double radius)
 	:GameObject(game), m_center(center), m_radius(radius)
 {
 	m_isFixed = true;
+	m_collisionCategory = COLLISION_CATEGORY_STATIC;
+	m_collisionShape = COLLISION_SHAPE_SPHERE;
 	AddVertsForSphere(m_vertexes, m_indexes, center, (float)radius, Rgba8::COLOR_WHITE);
 	CreateBuffer(g_theRenderer);
 
@@ -2174,6 +3143,11 @@ DoubleAABB3 Object_Sphere::GetBoundingBox() const
 	return DoubleAABB3(Min, Max);
 }
 
+RaycastResult3D Object_Sphere::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	return RaycastVsSphere3D(startPos, fwdNormal, maxDist, m_center, (float)m_radius);
+}
+
 bool Object_Sphere::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (!node->m_isNode) return false;
@@ -2186,6 +3160,8 @@ Object_Capsule::Object_Capsule(Game* game, DoubleCapsule3 capsule)
 	:GameObject(game), m_capsule(capsule)
 {
 	m_isFixed = true;
+	m_collisionCategory = COLLISION_CATEGORY_STATIC;
+	m_collisionShape = COLLISION_SHAPE_CAPSULE;
 	AddVertsForCapsule3D(m_vertexes, m_indexes, capsule, Rgba8::COLOR_WHITE);
 	CreateBuffer(g_theRenderer);
 
@@ -2224,6 +3200,11 @@ DoubleAABB3 Object_Capsule::GetBoundingBox() const
 	return m_capsule.GetBoundingBox();
 }
 
+RaycastResult3D Object_Capsule::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	return RaycastVsCapsule3D(startPos, fwdNormal, maxDist, m_capsule);
+}
+
 bool Object_Capsule::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (!node->m_isNode) return false;
@@ -3,9 +3,12 @@
 #include "Game/Ragdoll.hpp"
 #include "Game/GameObject.hpp"
 #include "Game/Octree.hpp"
+#include "Game/Replay.hpp"
 
 constexpr int MULTITHREADING_THRESHOLD = 10;
+constexpr int JOB_UTILIZATION_HISTORY = 120;
 constexpr int MAX_WAIT_FRAMES = 0;
+constexpr unsigned int WORLD_STATE_VERSION = 2;
 
 class Player;
 class Ragdoll;
@@ -17,6 +20,7 @@ struct Object_AABB : public GameObject
 
 	void Render() const override;
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleAABB3 m_aabb;
@@ -29,6 +33,7 @@ struct Object_OBB : public GameObject
 
 	void Render() const override;
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleOBB3 m_obb;
@@ -41,6 +46,7 @@ struct Object_Sphere : public GameObject
 
 	void Render() const override;
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleVec3 m_center;
@@ -54,6 +60,7 @@ struct Object_Capsule : public GameObject
 
 	void Render() const override;
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleCapsule3 m_capsule;
@@ -85,6 +92,18 @@ public:
 	void Update_Ragdolls(float deltaSeconds);
 	void ManagingRagdolls_Multi_Threaded(float deltaSeconds);
 	void ManagingRagdolls_Single_Threaded(float deltaSeconds);
+	void UpdateRagdollTimers(float deltaSeconds);
+	int ConsumeTimeDebt(float deltaSeconds);
+	void StepRagdolls_Serial(int iterations);
+	void FinishSimulationStep();
+	void KickSimulationStep();
+	void SyncSimulationStep();
+	uint64_t ComputeSimulationChecksum() const;
+
+	// World state: the step count, time debt, RNG and every ragdoll's state in one flat buffer.
+	// Restoring reuses ragdolls that still match and rebuilds the rest, so it works across spawns and breaks
+	void SaveWorldState(std::vector<uint8_t>& out_state);
+	bool RestoreWorldState(std::vector<uint8_t> const& state);
 
 	void IMGUI_UPDATE();
 
@@ -98,12 +117,22 @@ public:
 
 	void SpawnRagdoll(Mat44 transform, Rgba8 color, Vec3 initialVelocity);
 	void DeleteRagdoll(Ragdoll* r);
+	void PushRagdoll(Ragdoll* r, DoubleVec3 acceleration);
 
 	// UI
 	void Menu_Init();
 
 	void RaycastVsRagdolls();
 
+	// DEBUG COMMANDS
+	static bool Event_CollisionStats(EventArgs& args);
+	static bool Event_Deterministic(EventArgs& args);
+	static bool Event_WorldState(EventArgs& args);
+	static bool Event_Replay(EventArgs& args);
+	static bool Event_SolverBench(EventArgs& args);
+	static bool Event_NarrowphaseBench(EventArgs& args);
+	static bool Event_PrecisionBench(EventArgs& args);
+
 public:
 	Camera* m_screenCamera;
 	GameState m_currentState = GameState::ATTRACT_MODE;
@@ -113,6 +142,11 @@ public:
 
 	std::vector<GameObject*> m_allObjects;
 	Octree* m_octree = nullptr;
+	std::vector<FunctionJob*> m_stepJobs;		// the multithreaded step graph, built in Update_Ragdolls and queued at the end of Update
+	JobCounter m_stepCounter;
+	bool m_isStepInFlight = false;
+	float m_jobUtilizationHistory[JOB_UTILIZATION_HISTORY] = {};
+	int m_jobUtilizationIndex = 0;
 
 	Player* m_player = nullptr;
 	Clock* m_clock = nullptr;
@@ -139,6 +173,35 @@ public:
 	std::vector<Ragdoll*> m_ragdolls;
 
 	bool DEBUG_usingMultithreading = false;
+	bool DEBUG_parallelContactResolve = true;
+	bool DEBUG_logCollisionStats = false;
+
+	// Render draws m_renderSnapshotIndex while every fixed step publishes into the other snapshot,
+	// and the main thread flips them once the step has finished. With overlap on, the step graph
+	// keeps running on the workers while the main thread renders the previous step
+	int m_renderSnapshotIndex = 0;
+	bool m_hasNewRenderSnapshot = false;
+	bool DEBUG_overlapSimulation = true;
+
+	// How far the front snapshot is drawn from its previous step to its current one: the time debt
+	// left over after its steps, as a fraction of a step
+	float m_renderAlpha = 1.f;
+	bool DEBUG_interpolateRender = true;
+
+	// Deterministic mode advances ragdoll timers per fixed step instead of per frame, so a run gives
+	// bitwise identical results on any path and worker count; m_stepChecksum verifies it
+	bool DEBUG_deterministic = false;
+	bool DEBUG_logStepChecksums = false;
+	int m_simulationStep = 0;
+	uint64_t m_stepChecksum = 0;
+	std::vector<uint8_t> m_savedWorldState;		// reused, so saving every step does not allocate
+	unsigned int m_nextSpawnID = 1;
+
+	// Recording appends a frame per fixed step. A loaded replay freezes the live world and is drawn instead
+	ReplayRecorder m_replayRecorder;
+	ReplayPlayer m_replayPlayer;
+	bool m_isReplayPlaying = false;
+	float m_replayTime = 0.f;
 
 	// RAGDOLL DEBUG
 	double DEBUG_NodeMoveSpeed = 30000;
@@ -150,6 +213,7 @@ public:
 	float DEBUG_spawn_Roll = 0.f;
 	bool DEBUG_randomRotation = false;
 	bool DEBUG_breakable = false;
+	bool DEBUG_ragdollSelfCollision = true;
 	bool DEBUG_solveConstraintWithFixedIteration = true;
 	float DEBUG_ragdoll_deadTimer = 5.f;
 	float DEBUG_ragdoll_canRestTimer = 2.f;
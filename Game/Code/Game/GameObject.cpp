@@ -2,6 +2,20 @@
 #include "Game/Octree.hpp"
 #include "Game/Game.hpp"
 
+char const* GetCollisionShapeName(CollisionShape shape)
+{
+	switch (shape)
+	{
+	case COLLISION_SHAPE_SPHERE_NODE:	return "SphereNode";
+	case COLLISION_SHAPE_CAPSULE_NODE:	return "CapsuleNode";
+	case COLLISION_SHAPE_AABB:			return "AABB";
+	case COLLISION_SHAPE_OBB:			return "OBB";
+	case COLLISION_SHAPE_SPHERE:		return "Sphere";
+	case COLLISION_SHAPE_CAPSULE:		return "Capsule";
+	default:							return "Unknown";
+	}
+}
+
 GameObject::GameObject(Game* game)
 	:m_game(game)
 {
@@ -9,7 +23,7 @@ GameObject::GameObject(Game* game)
 }
 
 GameObject::GameObject(Game* game, DoubleMat44 transform)
-	:m_game(game), m_position(transform.GetTranslation3D()), m_orientation(transform.GetDoubleQuaternion())
+	:m_game(game), m_position(transform.GetTranslation3D()), m_orientation(transform.GetQuaternion())
 {
 
 }
@@ -31,7 +45,7 @@ CollisionRecord* GameObject::Node_Intersect(GameObject* obj)
 	{
 		return obj->Node_Intersect(this);
 	}
-	if (DoAABBsOverlap3D_Double(GetBoundingBox(), obj->GetBoundingBox()))
+	if (DoAABBsOverlap3D_Double(m_bounds, obj->m_bounds))
 	{
 		return new CollisionRecord((Node*)this, obj);
 	}
@@ -39,6 +53,31 @@ CollisionRecord* GameObject::Node_Intersect(GameObject* obj)
 	return nullptr;
 }
 
+void GameObject::RefreshBounds()
+{
+	m_bounds = GetBoundingBox();
+}
+
+bool GameObject::CanCollideWith(GameObject const* obj) const
+{
+	if ((m_collisionCategory & obj->m_collisionMask) == 0 || (obj->m_collisionCategory & m_collisionMask) == 0)
+	{
+		return false;
+	}
+
+	if (m_isNode && obj->m_isNode)
+	{
+		Node const* nodeA = (Node const*)this;
+		Node const* nodeB = (Node const*)obj;
+		if (nodeA->m_ragdoll == nodeB->m_ragdoll)
+		{
+			return nodeA->m_ragdoll->CanNodesCollide(nodeA->m_nodeIndex, nodeB->m_nodeIndex);
+		}
+	}
+
+	return true;
+}
+
 void GameObject::CreateBuffer(Renderer* renderer)
 {
 	m_vbuffer = renderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN) * (unsigned int)m_vertexes.size());
@@ -4,11 +4,32 @@
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Core/RaycastUtils.hpp"
 
 class Game;
 struct Node;
 struct CollisionRecord;
-struct Octree;
+
+enum CollisionCategory : unsigned int
+{
+	COLLISION_CATEGORY_NONE		= 0,
+	COLLISION_CATEGORY_STATIC	= 1 << 0,
+	COLLISION_CATEGORY_RAGDOLL	= 1 << 1,
+	COLLISION_CATEGORY_ALL		= 0xFFFFFFFF,
+};
+
+enum CollisionShape
+{
+	COLLISION_SHAPE_SPHERE_NODE,
+	COLLISION_SHAPE_CAPSULE_NODE,
+	COLLISION_SHAPE_AABB,
+	COLLISION_SHAPE_OBB,
+	COLLISION_SHAPE_SPHERE,
+	COLLISION_SHAPE_CAPSULE,
+	NUM_COLLISION_SHAPES
+};
+
+char const* GetCollisionShapeName(CollisionShape shape);
 
 class GameObject
 {
@@ -19,10 +40,13 @@ public:
 
 	virtual void Render() const = 0;
 	virtual DoubleAABB3 GetBoundingBox() const = 0;
+	virtual RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const = 0;
 
 	virtual bool CollisionResolveVsRagdollNode(Node* node) = 0;
 
-	CollisionRecord* Node_Intersect(GameObject* obj);
+	CollisionRecord* Node_Intersect(GameObject* obj);	// bounds only, Octree::TestPair has already applied CanCollideWith
+	void RefreshBounds();
+	bool CanCollideWith(GameObject const* obj) const;
 	void CreateBuffer(Renderer* renderer);
 
 	DoubleMat44 GetModelMatrix() const;
@@ -68,6 +92,11 @@ public:
 	bool m_isFixed = false;
 	bool m_isNode = false;
 
-	Octree* m_currentOctree = nullptr;
+	unsigned int m_collisionCategory = COLLISION_CATEGORY_ALL;
+	unsigned int m_collisionMask = COLLISION_CATEGORY_ALL;
+	CollisionShape m_collisionShape = COLLISION_SHAPE_AABB;
+
+	int m_octreeNode = -1;
+	DoubleAABB3 m_bounds;		// GetBoundingBox() as of the octree's last refit
 };
 
@@ -2,232 +2,237 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Game/Game.hpp"
 
-Octree::Octree()
-	:m_region(DoubleAABB3(0, 0, 0, 0, 0, 0))
+static DoubleAABB3 GetOctantRegion(DoubleAABB3 const& region, int octant)
 {
-	m_curLife = -1;
-}
-
-Octree::Octree(DoubleAABB3 region, std::vector<GameObject*> objects)
-	:m_region(region), m_objects(objects)
-{
-	for (size_t i = 0; i < m_objects.size(); i++)
+	DoubleVec3 center = region.m_mins + (region.m_maxs - region.m_mins) / 2.0;
+	switch (octant)
 	{
-		m_objects[i]->m_currentOctree = this;
+	case 0: return DoubleAABB3(region.m_mins, center);
+	case 1: return DoubleAABB3(DoubleVec3(center.x, region.m_mins.y, region.m_mins.z), DoubleVec3(region.m_maxs.x, center.y, center.z));
+	case 2: return DoubleAABB3(DoubleVec3(center.x, region.m_mins.y, center.z), DoubleVec3(region.m_maxs.x, center.y, region.m_maxs.z));
+	case 3: return DoubleAABB3(DoubleVec3(region.m_mins.x, region.m_mins.y, center.z), DoubleVec3(center.x, center.y, region.m_maxs.z));
+	case 4: return DoubleAABB3(DoubleVec3(region.m_mins.x, center.y, region.m_mins.z), DoubleVec3(center.x, region.m_maxs.y, center.z));
+	case 5: return DoubleAABB3(DoubleVec3(center.x, center.y, region.m_mins.z), DoubleVec3(region.m_maxs.x, region.m_maxs.y, center.z));
+	case 6: return DoubleAABB3(center, region.m_maxs);
+	default: return DoubleAABB3(DoubleVec3(region.m_mins.x, center.y, center.z), DoubleVec3(center.x, region.m_maxs.y, region.m_maxs.z));
 	}
-	m_curLife = -1;
 }
 
-Octree::Octree(DoubleAABB3 region)
-	:m_region(region)
+static bool IsAtMinSize(DoubleAABB3 const& region)
 {
-	m_curLife = -1;
+	DoubleVec3 dimensions = region.m_maxs - region.m_mins;
+	return dimensions.x <= OCTREE_MIN_SIZE && dimensions.y <= OCTREE_MIN_SIZE && dimensions.z <= OCTREE_MIN_SIZE;
 }
 
-Octree::~Octree()
+Octree::Octree(DoubleAABB3 region, std::vector<GameObject*> objects)
 {
-	delete m_debugbuffer;
+	m_nodes.reserve(1 + 8 * OCTREE_INITIAL_BLOCKS);
+	m_objectSlots.reserve(objects.size());
+
+	OctreeNode root;
+	root.m_region = region;
+	m_nodes.push_back(root);
 
-	for (auto& i : m_childNode)
+	for (GameObject* object : objects)
 	{
-		if (i)
-		{
-			delete i;
-		}
+		object->RefreshBounds();
+		AddObject(OCTREE_ROOT, object);
 	}
 }
 
+Octree::~Octree()
+{
+}
+
 void Octree::Update()
 {
+	RefitObjects();
+	FindCollisionPairs();
+	ResolveCollisionPairs();
+	Maintain();
+}
+
+void Octree::RefitObjects()
+{
+	RefreshObjectBounds();
+
+	m_isStepSkipped = false;
 	if (!bm_built || !bm_ready)
 	{
-		BuildTree();
+		// The step that builds the tree does no collision work
+		BuildTree(OCTREE_ROOT);
+		m_isStepSkipped = true;
 		return;
 	}
 
-	UpdateTreeObjects(this);
+	m_stats = OctreeStats();
+	UpdateTreeObjects(OCTREE_ROOT);
+}
 
-	if (m_isRoot)
-	{
-		std::vector<GameObject*> newList;
-		std::vector<CollisionRecord*> recordList = GetIntersection(newList);
+void Octree::FindCollisionPairs()
+{
+	if (m_isStepSkipped) return;
+	GetIntersection(OCTREE_ROOT, m_stepRecords);
+}
 
-		for (auto & i : recordList)
-		{
-			i->Resolve();
-		}
-	}
+void Octree::ResolveCollisionPairs()
+{
+	if (m_isStepSkipped) return;
+	ResolveCollisions(m_stepRecords);
 
-	// FOR DEBUG ---------------------------------------
-	for (GameObject* n : m_objects)
+	for (auto& i : m_stepRecords)
 	{
-		n->m_currentOctree = this;
+		if (i->m_hadContact) m_stats.m_contacts++;
+		delete i;
 	}
-	// -------------------------------------------------
-
-	PruneDeadBranches(this);
+	m_stepRecords.clear();
 }
 
+void Octree::Maintain()
+{
+	if (m_isStepSkipped) return;
+	PruneDeadBranches(OCTREE_ROOT);
+	GatherTreeStats(OCTREE_ROOT);
+
+	if (g_theGame->DEBUG_logCollisionStats)
+	{
+		DebuggerPrintf("%s", m_stats.ToString().c_str());
+	}
+}
 
 void Octree::Render() const
 {
+	std::vector<Vertex_PCU> verts;
+	verts.reserve((size_t)GetNumActiveNodes() * 24);
+	AddVertsForNode(OCTREE_ROOT, verts);
+	if (verts.empty()) return;
+
 	g_theRenderer->BindShader(nullptr);
 	g_theRenderer->BindTexture(nullptr, 0);
 	g_theRenderer->BindTexture(nullptr, 1);
 	g_theRenderer->BindTexture(nullptr, 2);
 	g_theRenderer->SetDepthStencilMode(DepthMode::ENABLED);
+	g_theRenderer->SetModelConstants(Mat44(), Rgba8::COLOR_WHITE);
+	g_theRenderer->DrawVertexArray(verts.size(), verts.data(), true);
+}
+
+void Octree::AddVertsForNode(int nodeIndex, std::vector<Vertex_PCU>& verts) const
+{
+	OctreeNode const& node = m_nodes[nodeIndex];
 
 	Rgba8 color = Rgba8::COLOR_PINK;
-	if (m_curLife != -1)
+	if (node.m_curLife != -1)
 	{
-		float currentLifePercent = RangeMap((float)m_curLife, 0.f, (float)m_maxLifespan, 0.f, 1.f);
+		float currentLifePercent = RangeMap((float)node.m_curLife, 0.f, (float)node.m_maxLifespan, 0.f, 1.f);
 		color = Interpolate(Rgba8::COLOR_PINK, Rgba8::COLOR_BLACK, currentLifePercent);
 	}
+	AddVertsForLineAABB3D(verts, node.m_region, color);
 
-	g_theRenderer->SetModelConstants(Mat44(), color);
-	if (m_debugbuffer) g_theRenderer->DrawVertexBuffer(m_debugbuffer, m_debugvertexes.size());
-
-	if (HasChildren())
+	for (int flags = node.m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
 	{
-		for (int flags = m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+		if ((flags & 1) == 1)
 		{
-			if ((flags & 1) == 1)
-			{
-				m_childNode[index]->Render();
-			}
+			AddVertsForNode(node.m_firstChild + index, verts);
 		}
 	}
 }
 
-bool Octree::Insert(GameObject* object)
+bool Octree::Insert(int nodeIndex, GameObject* object)
 {
-	if (m_objects.empty() && m_activeNodes == 0)
+	if (m_nodes[nodeIndex].m_numObjects == 0 && !m_nodes[nodeIndex].HasChildren())
 	{
-		m_objects.push_back(object);
-		object->m_currentOctree = this;
+		AddObject(nodeIndex, object);
 		return true;
 	}
 
-	DoubleVec3 dimensions = m_region.m_maxs - m_region.m_mins;
-	if (dimensions.x <= MIN_SIZE && dimensions.y <= MIN_SIZE && dimensions.z <= MIN_SIZE)
+	if (IsAtMinSize(m_nodes[nodeIndex].m_region))
 	{
-		m_objects.push_back(object);
+		AddObject(nodeIndex, object);
 		return true;
 	}
-	if (!IsAABBInside(m_region, object->GetBoundingBox()))
+
+	DoubleAABB3 const& bounds = object->m_bounds;
+	if (!IsAABBInside(m_nodes[nodeIndex].m_region, bounds))
 	{
-		if (m_parent)
-		{
-			return m_parent->Insert(object);
-		}
-		else
+		if (m_nodes[nodeIndex].m_parent != -1)
 		{
-			return false;
+			return Insert(m_nodes[nodeIndex].m_parent, object);
 		}
+		return false;
 	}
-	else
-	{
-		DoubleVec3 half = dimensions / 2.0;
-		DoubleVec3 center = m_region.m_mins + half;
-
-		DoubleAABB3 childOctant[8];
-		childOctant[0] = (m_childNode[0]) ? m_childNode[0]->m_region : DoubleAABB3(m_region.m_mins, center);
-		childOctant[1] = (m_childNode[1]) ? m_childNode[1]->m_region : DoubleAABB3(DoubleVec3(center.x, m_region.m_mins.y, m_region.m_mins.z), DoubleVec3(m_region.m_maxs.x, center.y, center.z));
-		childOctant[2] = (m_childNode[2]) ? m_childNode[2]->m_region : DoubleAABB3(DoubleVec3(center.x, m_region.m_mins.y, center.z), DoubleVec3(m_region.m_maxs.x, center.y, m_region.m_maxs.z));
-		childOctant[3] = (m_childNode[3]) ? m_childNode[3]->m_region : DoubleAABB3(DoubleVec3(m_region.m_mins.x, m_region.m_mins.y, center.z), DoubleVec3(center.x, center.y, m_region.m_maxs.z));
-		childOctant[4] = (m_childNode[4]) ? m_childNode[4]->m_region : DoubleAABB3(DoubleVec3(m_region.m_mins.x, center.y, m_region.m_mins.z), DoubleVec3(center.x, m_region.m_maxs.y, center.z));
-		childOctant[5] = (m_childNode[5]) ? m_childNode[5]->m_region : DoubleAABB3(DoubleVec3(center.x, center.y, m_region.m_mins.z), DoubleVec3(m_region.m_maxs.x, m_region.m_maxs.y, center.z));
-		childOctant[6] = (m_childNode[6]) ? m_childNode[6]->m_region : DoubleAABB3(center, m_region.m_maxs);
-		childOctant[7] = (m_childNode[7]) ? m_childNode[7]->m_region : DoubleAABB3(DoubleVec3(m_region.m_mins.x, center.y, center.z), DoubleVec3(center.x, m_region.m_maxs.y, m_region.m_maxs.z));
-
-		bool found = false;
 
-		for (size_t i = 0; i < 8; i++)
+	for (int i = 0; i < 8; i++)
+	{
+		if (IsAABBInside(GetOctantRegion(m_nodes[nodeIndex].m_region, i), bounds))
 		{
-			if (IsAABBInside(childOctant[i], object->GetBoundingBox()))
+			if (m_nodes[nodeIndex].m_activeNodes & (1 << i))
 			{
-				if (m_childNode[i])
-				{
-					return m_childNode[i]->Insert(object);
-				}
-				else
-				{
-					m_childNode[i] = CreateNode(childOctant[i], object);
-					m_activeNodes |= (1 << i);
-				}
-				found = true;
-				break;
+				return Insert(m_nodes[nodeIndex].m_firstChild + i, object);
 			}
-		}
 
-		if (!found)
-		{
-			m_objects.push_back(object);
-			object->m_currentOctree = this;
+			AddObject(ActivateChild(nodeIndex, i), object);
 			return true;
 		}
 	}
 
-	return false;
+	AddObject(nodeIndex, object);
+	return true;
 }
 
-void Octree::BuildTree()
+void Octree::BuildTree(int nodeIndex)
 {
-	if (m_objects.empty()) 	return;
-	DoubleVec3 dimensions = m_region.m_maxs - m_region.m_mins;
+	if (m_nodes[nodeIndex].m_numObjects == 0) return;
+	if (IsAtMinSize(m_nodes[nodeIndex].m_region)) return;
 
-	if (dimensions.x <= MIN_SIZE && dimensions.y <= MIN_SIZE && dimensions.z <= MIN_SIZE)
+	DoubleAABB3 octant[8];
+	for (int i = 0; i < 8; i++)
 	{
-		return;
+		octant[i] = GetOctantRegion(m_nodes[nodeIndex].m_region, i);
 	}
 
-	DoubleVec3 half = dimensions / 2.0;
-	DoubleVec3 center = m_region.m_mins + half;
-
-	DoubleAABB3 octant[8];
-	octant[0] = DoubleAABB3(m_region.m_mins, center);
-	octant[1] = DoubleAABB3(DoubleVec3(center.x, m_region.m_mins.y, m_region.m_mins.z), DoubleVec3(m_region.m_maxs.x, center.y, center.z));
-	octant[2] = DoubleAABB3(DoubleVec3(center.x, m_region.m_mins.y, center.z), DoubleVec3(m_region.m_maxs.x, center.y, m_region.m_maxs.z));
-	octant[3] = DoubleAABB3(DoubleVec3(m_region.m_mins.x, m_region.m_mins.y, center.z), DoubleVec3(center.x, center.y, m_region.m_maxs.z));
-	octant[4] = DoubleAABB3(DoubleVec3(m_region.m_mins.x, center.y, m_region.m_mins.z), DoubleVec3(center.x, m_region.m_maxs.y, center.z));
-	octant[5] = DoubleAABB3(DoubleVec3(center.x, center.y, m_region.m_mins.z), DoubleVec3(m_region.m_maxs.x, m_region.m_maxs.y, center.z));
-	octant[6] = DoubleAABB3(center, m_region.m_maxs);
-	octant[7] = DoubleAABB3(DoubleVec3(m_region.m_mins.x, center.y, center.z), DoubleVec3(center.x, m_region.m_maxs.y, m_region.m_maxs.z));
+	// Detach the whole list, then relink every slot either back here or into the child that fits it
+	int slot = m_nodes[nodeIndex].m_firstObject;
+	m_nodes[nodeIndex].m_firstObject = -1;
+	m_nodes[nodeIndex].m_numObjects = 0;
 
-	std::vector<GameObject*> octObjects[8];
-	std::vector<GameObject*> delist;
-
-	for (GameObject* n : m_objects)
+	unsigned char newChildren = 0;
+	while (slot != -1)
 	{
-		for (size_t i = 0; i < 8; i++)
+		int next = m_objectSlots[slot].m_next;
+		DoubleAABB3 const& bounds = m_objectSlots[slot].m_object->m_bounds;
+
+		int target = nodeIndex;
+		for (int i = 0; i < 8; i++)
 		{
-			if (IsAABBInside(octant[i], n->GetBoundingBox()))
+			if (IsAABBInside(octant[i], bounds))
 			{
-				octObjects[i].push_back(n);
-				delist.push_back(n);
+				if ((m_nodes[nodeIndex].m_activeNodes & (1 << i)) == 0)
+				{
+					ActivateChild(nodeIndex, i);
+					newChildren |= (1 << i);
+				}
+				target = m_nodes[nodeIndex].m_firstChild + i;
 				break;
 			}
 		}
-	}
 
-	for (GameObject* n : delist)
-	{
-		auto it = std::find(m_objects.begin(), m_objects.end(), n);
-		m_objects.erase(it);
+		LinkObjectSlot(target, slot);
+		slot = next;
 	}
 
-	for (int a = 0; a < 8; a++)
+	for (int flags = newChildren, index = 0; flags > 0; flags >>= 1, index++)
 	{
-		if (!octObjects[a].empty())
+		if ((flags & 1) == 1)
 		{
-			m_childNode[a] = CreateNode(octant[a], octObjects[a]);
-			m_activeNodes |= (1 << a);
-			m_childNode[a]->BuildTree();
+			BuildTree(m_nodes[nodeIndex].m_firstChild + index);
 		}
 	}
 
-	bm_built = true;
-	bm_ready = true;
+	if (nodeIndex == OCTREE_ROOT)
+	{
+		bm_built = true;
+		bm_ready = true;
+	}
 }
 
 void Octree::UpdateTree()
@@ -235,27 +240,42 @@ void Octree::UpdateTree()
 	bm_ready = false;
 	if (!bm_built)
 	{
-		while (!m_pendingInsertion.empty())
+		for (GameObject* object : m_pendingInsertion)
 		{
-			m_objects.push_back(m_pendingInsertion.front());
-			m_pendingInsertion.pop_front();
+			object->RefreshBounds();
+			AddObject(OCTREE_ROOT, object);
 		}
-		BuildTree();
+		BuildTree(OCTREE_ROOT);
 	}
 	else
 	{
-		while (!m_pendingInsertion.empty())
+		for (GameObject* object : m_pendingInsertion)
 		{
-			Insert(m_pendingInsertion.front());
-			m_pendingInsertion.pop_front();
+			object->RefreshBounds();
+			Insert(OCTREE_ROOT, object);
 		}
 	}
+	m_pendingInsertion.clear();
 	bm_ready = true;
 }
 
 void Octree::ResetTreeObjects(std::vector<GameObject*> objects)
 {
-	m_objects.clear();
+	OctreeNode root;
+	root.m_region = m_nodes[OCTREE_ROOT].m_region;
+
+	for (OctreeObjectSlot& slot : m_objectSlots)
+	{
+		if (slot.m_object) slot.m_object->m_octreeNode = -1;
+	}
+
+	m_nodes.clear();
+	m_nodes.push_back(root);
+	m_freeBlocks.clear();
+	m_objectSlots.clear();
+	m_freeObjectSlot = -1;
+	bm_built = false;
+
 	for (auto object : objects)
 	{
 		m_pendingInsertion.push_back(object);
@@ -263,222 +283,592 @@ void Octree::ResetTreeObjects(std::vector<GameObject*> objects)
 	UpdateTree();
 }
 
-bool Octree::HasChildren() const
+int Octree::GetNumActiveNodes() const
 {
-	for (Octree* child : m_childNode)
+	return (int)m_nodes.size() - (int)m_freeBlocks.size() * 8;
+}
+
+OctreeStats const& Octree::GetStats() const
+{
+	return m_stats;
+}
+
+void Octree::GatherTreeStats(int nodeIndex)
+{
+	OctreeNode const& node = m_nodes[nodeIndex];
+	m_stats.m_numNodes++;
+	m_stats.m_treeDepth = std::max(m_stats.m_treeDepth, node.m_layer);
+
+	if (!node.HasChildren())
 	{
-		if (child) return true;
+		m_stats.m_numLeaves++;
+		m_stats.m_maxObjectsPerLeaf = std::max(m_stats.m_maxObjectsPerLeaf, node.m_numObjects);
+		return;
 	}
 
-	return false;
+	for (int flags = node.m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+	{
+		if ((flags & 1) == 1)
+		{
+			GatherTreeStats(node.m_firstChild + index);
+		}
+	}
 }
 
-Octree* Octree::CreateNode(DoubleAABB3 region, std::vector<GameObject*> objects)
+int Octree::ActivateChild(int nodeIndex, int octant)
 {
-	if (objects.empty()) return nullptr;
-	Octree* tree = new Octree(region, objects);
-	tree->m_parent = this;
-	tree->m_layer = tree->m_parent->m_layer + 1;
-	tree->m_name = Stringf("Octree layer: %i", tree->m_layer);
-	tree->Init();
-	return tree;
+	if (m_nodes[nodeIndex].m_firstChild == -1)
+	{
+		int firstChild;
+		if (!m_freeBlocks.empty())
+		{
+			firstChild = m_freeBlocks.back();
+			m_freeBlocks.pop_back();
+		}
+		else
+		{
+			firstChild = (int)m_nodes.size();
+			m_nodes.resize(m_nodes.size() + 8);
+		}
+		m_nodes[nodeIndex].m_firstChild = firstChild;
+	}
+
+	OctreeNode& parent = m_nodes[nodeIndex];
+	int childIndex = parent.m_firstChild + octant;
+
+	OctreeNode child;
+	child.m_region = GetOctantRegion(parent.m_region, octant);
+	child.m_parent = nodeIndex;
+	child.m_layer = parent.m_layer + 1;
+	m_nodes[childIndex] = child;
+
+	parent.m_activeNodes |= (1 << octant);
+	return childIndex;
+}
+
+void Octree::DeactivateChild(int nodeIndex, int octant)
+{
+	OctreeNode& parent = m_nodes[nodeIndex];
+	parent.m_activeNodes &= (unsigned char)~(1 << octant);
+	if (parent.m_activeNodes == 0)
+	{
+		m_freeBlocks.push_back(parent.m_firstChild);
+		parent.m_firstChild = -1;
+	}
+}
+
+void Octree::AddObject(int nodeIndex, GameObject* object)
+{
+	int slot = m_freeObjectSlot;
+	if (slot != -1)
+	{
+		m_freeObjectSlot = m_objectSlots[slot].m_next;
+	}
+	else
+	{
+		slot = (int)m_objectSlots.size();
+		m_objectSlots.emplace_back();
+	}
+
+	m_objectSlots[slot].m_object = object;
+	LinkObjectSlot(nodeIndex, slot);
 }
 
-Octree* Octree::CreateNode(DoubleAABB3 region, GameObject* object)
+void Octree::LinkObjectSlot(int nodeIndex, int slot)
 {
-	if (!object) return nullptr;
-	std::vector<GameObject*> objectList;
-	objectList.push_back(object);
-	Octree* tree = new Octree(region, objectList);
-	tree->m_parent = this;
-	tree->m_layer = tree->m_parent->m_layer + 1;
-	tree->m_name = Stringf("Octree layer: %i", tree->m_layer);
-	tree->Init();
-	return tree;
+	OctreeNode& node = m_nodes[nodeIndex];
+	m_objectSlots[slot].m_next = node.m_firstObject;
+	node.m_firstObject = slot;
+	node.m_numObjects++;
+	m_objectSlots[slot].m_object->m_octreeNode = nodeIndex;
 }
 
-void Octree::UpdateTreeObjects(Octree* tree)
+void Octree::RemoveObject(int nodeIndex, GameObject* object)
 {
-	std::vector<GameObject*> movedObjects;
+	OctreeNode& node = m_nodes[nodeIndex];
+	int prev = -1;
+	for (int slot = node.m_firstObject; slot != -1; prev = slot, slot = m_objectSlots[slot].m_next)
+	{
+		if (m_objectSlots[slot].m_object != object) continue;
+
+		if (prev == -1) node.m_firstObject = m_objectSlots[slot].m_next;
+		else m_objectSlots[prev].m_next = m_objectSlots[slot].m_next;
+		node.m_numObjects--;
+
+		m_objectSlots[slot].m_object = nullptr;
+		m_objectSlots[slot].m_next = m_freeObjectSlot;
+		m_freeObjectSlot = slot;
+		object->m_octreeNode = -1;
+		return;
+	}
+}
 
-	//Update & move all objects in the node
-	for (auto& object : tree->m_objects)
+void Octree::RefreshObjectBounds()
+{
+	// Only moving nodes change shape between steps; everything else keeps the bounds it was inserted with
+	g_theJobSystem->ParallelFor(0, (int)m_objectSlots.size(), OCTREE_BOUNDS_GRAIN, [this](int slot)
 	{
-		if(!object) continue;
+		GameObject* object = m_objectSlots[slot].m_object;
+		if (object && object->m_isNode && !object->m_isFixed)
+		{
+			object->RefreshBounds();
+		}
+	});
+}
 
+void Octree::UpdateTreeObjects(int nodeIndex)
+{
+	size_t firstMoved = m_movedObjects.size();
+
+	for (int slot = m_nodes[nodeIndex].m_firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
+	{
+		GameObject* object = m_objectSlots[slot].m_object;
 		if (object->m_isNode && !object->m_isFixed)
 		{
-			movedObjects.push_back(object);
+			m_movedObjects.push_back(object);
 		}
 	}
 
 	//update any child nodes
-	if (tree->HasChildren())
+	for (int flags = m_nodes[nodeIndex].m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
 	{
-		for (int flags = tree->m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+		if ((flags & 1) == 1)
 		{
-			if ((flags & 1) == 1)
-			{
-				UpdateTreeObjects(tree->m_childNode[index]);
-			}
+			UpdateTreeObjects(m_nodes[nodeIndex].m_firstChild + index);
 		}
 	}
 
-	for (auto& movedObj : movedObjects)
+	for (size_t i = firstMoved; i < m_movedObjects.size(); i++)
 	{
-		if(!movedObj) continue;
-
-		Octree* current = tree;
-		auto it = std::find(current->m_objects.begin(), current->m_objects.end(), movedObj);
-		current->m_objects.erase(it);
+		GameObject* movedObj = m_movedObjects[i];
+		RemoveObject(nodeIndex, movedObj);
+		m_stats.m_reinsertions++;
 
-		while (!IsAABBInside(current->m_region, movedObj->GetBoundingBox()))
+		DoubleAABB3 const& bounds = movedObj->m_bounds;
+		int current = nodeIndex;
+		while (!IsAABBInside(m_nodes[current].m_region, bounds) && m_nodes[current].m_parent != -1)
 		{
-			if (current->m_parent) current = current->m_parent;
-			else
-			{
-				break;
-			}
+			current = m_nodes[current].m_parent;
 		}
 
-		current->Insert(movedObj);
+		Insert(current, movedObj);
+		if (movedObj->m_octreeNode != nodeIndex) m_stats.m_nodeChanges++;
 	}
+
+	m_movedObjects.resize(firstMoved);
 }
 
-void Octree::PruneDeadBranches(Octree* tree)
+void Octree::PruneDeadBranches(int nodeIndex)
 {
-	if (tree->m_objects.empty())
+	OctreeNode& node = m_nodes[nodeIndex];
+	if (node.m_numObjects == 0)
 	{
-		if (!tree->HasChildren())
+		if (!node.HasChildren())
 		{
-			if (tree->m_curLife == -1)
+			if (node.m_curLife == -1)
 			{
-				tree->m_curLife = tree->m_maxLifespan;
+				node.m_curLife = node.m_maxLifespan;
 			}
-			else if (tree->m_curLife > 0)
+			else if (node.m_curLife > 0)
 			{
-				tree->m_curLife--;
+				node.m_curLife--;
 			}
 		}
 	}
 	else
 	{
-		if (tree->m_curLife != -1)
+		if (node.m_curLife != -1)
 		{
-			if (tree->m_maxLifespan <= 64)
+			if (node.m_maxLifespan <= 64)
 			{
-				tree->m_maxLifespan *= 2;
+				node.m_maxLifespan *= 2;
 			}
 
-			tree->m_curLife = -1;
+			node.m_curLife = -1;
 		}
 	}
 
 	//prune out any dead branches in the tree
-	for (int flags = tree->m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+	int firstChild = node.m_firstChild;
+	for (int flags = node.m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
 	{
 		if ((flags & 1) == 1)
 		{
-			PruneDeadBranches(tree->m_childNode[index]);
+			PruneDeadBranches(firstChild + index);
 
-			if (tree->m_childNode[index]->m_curLife == 0)
+			if (m_nodes[firstChild + index].m_curLife == 0)
 			{
-				if (!tree->m_childNode[index]->m_objects.empty())
+				if (m_nodes[firstChild + index].m_numObjects != 0)
 				{
 					ERROR_AND_DIE("Tried to delete a used branch!");
 				}
-				else
-				{
-					delete tree->m_childNode[index];
-					tree->m_childNode[index] = nullptr;
-					tree->m_activeNodes ^= (byte)(1 << index);
-				}
+				DeactivateChild(nodeIndex, index);
 			}
 		}
 	}
 }
 
-void Octree::Init()
+void Octree::GetIntersection(int nodeIndex, std::vector<CollisionRecord*>& out_records)
+{
+	int firstObject = m_nodes[nodeIndex].m_firstObject;
+
+	for (GameObject* pObj : m_ancestorObjects)
+	{
+		for (int slot = firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
+		{
+			TestPair(pObj, m_objectSlots[slot].m_object, out_records);
+		}
+	}
+
+	for (int slotA = firstObject; slotA != -1; slotA = m_objectSlots[slotA].m_next)
+	{
+		for (int slotB = firstObject; slotB != -1; slotB = m_objectSlots[slotB].m_next)
+		{
+			if (slotA == slotB) continue;
+
+			TestPair(m_objectSlots[slotA].m_object, m_objectSlots[slotB].m_object, out_records);
+		}
+	}
+
+	size_t numAncestors = m_ancestorObjects.size();
+	for (int slot = firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
+	{
+		m_ancestorObjects.push_back(m_objectSlots[slot].m_object);
+	}
+
+	for (int flags = m_nodes[nodeIndex].m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+	{
+		if ((flags & 1) == 1)
+		{
+			GetIntersection(m_nodes[nodeIndex].m_firstChild + index, out_records);
+		}
+	}
+
+	m_ancestorObjects.resize(numAncestors);
+}
+
+void Octree::TestPair(GameObject* objA, GameObject* objB, std::vector<CollisionRecord*>& out_records)
 {
-	AddVertsForLineAABB3D(m_debugvertexes, m_region, Rgba8::COLOR_WHITE);
-	m_debugbuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCU) * (unsigned int)m_debugvertexes.size());
-	g_theRenderer->CopyCPUToGPU(m_debugvertexes.data(), (int)(m_debugvertexes.size() * sizeof(Vertex_PCU)), m_debugbuffer);
-	m_debugbuffer->SetIsLinePrimitive(true);
+	if (!objA->m_isNode && !objB->m_isNode) return;
+
+	m_stats.m_candidatePairs++;
+	if (!objA->CanCollideWith(objB))
+	{
+		m_stats.m_pairsFilteredByMask++;
+		return;
+	}
+
+	CollisionRecord* record = objA->Node_Intersect(objB);
+	if (!record)
+	{
+		m_stats.m_pairsRejectedByAABB++;
+		return;
+	}
+
+	m_stats.m_narrowphaseTests[record->m_node->m_collisionShape][record->m_object->m_collisionShape]++;
+	out_records.push_back(record);
 }
 
-std::vector<CollisionRecord*> Octree::GetIntersection(std::vector<GameObject*> parentObj)
+void Octree::ResolveCollisions(std::vector<CollisionRecord*> const& records)
 {
-	std::vector<CollisionRecord*> collisions;
+	BuildContactIslands(records);
 
-	for (GameObject* pObj : parentObj)
+	bool goWide = g_theGame->DEBUG_parallelContactResolve && g_theJobSystem->GetWorkersSize() > 0 && (int)records.size() >= CONTACT_PARALLEL_THRESHOLD && m_islands.size() > 1;
+	if (!goWide)
 	{
-		for (GameObject* lObj : m_objects)
+		for (auto& island : m_islands)
 		{
-			if (pObj && lObj)
-			{
-				CollisionRecord* record = pObj->Node_Intersect(lObj);
-				if (record)
-				{
-					collisions.push_back(record);
-				}
-			}
+			ResolveContactIsland(island);
 		}
+		return;
+	}
+
+	g_theJobSystem->ParallelFor(0, (int)m_islands.size(), 1, [this](int i)
+	{
+		ResolveContactIsland(m_islands[i]);
+	});
+}
+
+static int FindIslandRoot(std::vector<int>& parents, int index)
+{
+	while (parents[index] != index)
+	{
+		parents[index] = parents[parents[index]];
+		index = parents[index];
 	}
+	return index;
+}
 
-	if (m_objects.size() > 1)
+void Octree::BuildContactIslands(std::vector<CollisionRecord*> const& records)
+{
+	m_islands.clear();
+	m_islandRecords.clear();
+	m_islandParents.clear();
+	m_recordIslands.clear();
+	m_islandRagdolls.clear();
+	m_rootIslands.clear();
+
+	// Index the ragdolls in the order records first reach them, and union across node-vs-node contacts
+	auto getRagdollIndex = [&](Ragdoll* ragdoll)
 	{
-		std::vector<GameObject*> tmp = m_objects;
-		while (!tmp.empty())
+		if (ragdoll->m_islandIndex == -1)
 		{
-			if (!tmp[tmp.size() - 1])
-			{
-				tmp.pop_back();
-				continue;
-			}
+			ragdoll->m_islandIndex = (int)m_islandRagdolls.size();
+			m_islandRagdolls.push_back(ragdoll);
+			m_islandParents.push_back((int)m_islandParents.size());
+		}
+		return ragdoll->m_islandIndex;
+	};
 
-			for (GameObject* lObj : m_objects)
-			{
-				if (!lObj)
-				{
-					continue;
-				}
-				if (tmp[tmp.size() - 1] == lObj)
-				{
-					continue;
-				}
+	for (auto& record : records)
+	{
+		int indexA = getRagdollIndex(record->m_node->m_ragdoll);
+		if (!record->m_object->m_isNode) continue;
 
-				CollisionRecord* record = tmp[tmp.size() - 1]->Node_Intersect(lObj);
-				if (record)
-				{
-					collisions.push_back(record);
-				}
-			}
+		int indexB = getRagdollIndex(((Node*)record->m_object)->m_ragdoll);
+		int rootA = FindIslandRoot(m_islandParents, indexA);
+		int rootB = FindIslandRoot(m_islandParents, indexB);
+		if (rootA != rootB)
+		{
+			// The smaller index wins so roots do not depend on the order unions happen in
+			if (rootA < rootB) m_islandParents[rootB] = rootA;
+			else m_islandParents[rootA] = rootB;
+		}
+	}
+
+	// Number islands by their first record, then lay their records out contiguously in step order
+	m_rootIslands.resize(m_islandRagdolls.size(), -1);
+	m_recordIslands.reserve(records.size());
+	for (auto& record : records)
+	{
+		int root = FindIslandRoot(m_islandParents, record->m_node->m_ragdoll->m_islandIndex);
+		if (m_rootIslands[root] == -1)
+		{
+			m_rootIslands[root] = (int)m_islands.size();
+			m_islands.push_back(ContactIsland());
+		}
+		m_islands[m_rootIslands[root]].m_numRecords++;
+		m_recordIslands.push_back(m_rootIslands[root]);
+	}
+
+	for (size_t i = 0; i < m_islandRagdolls.size(); i++)
+	{
+		if (!m_islandRagdolls[i]->m_isDead)
+		{
+			m_islands[m_rootIslands[FindIslandRoot(m_islandParents, (int)i)]].m_isAwake = true;
+		}
+		m_islandRagdolls[i]->m_islandIndex = -1;
+	}
+
+	int nextRecord = 0;
+	for (auto& island : m_islands)
+	{
+		island.m_firstRecord = nextRecord;
+		nextRecord += island.m_numRecords;
+		island.m_numRecords = 0;
+
+		if (!island.m_isAwake) m_stats.m_sleepingIslands++;
+	}
+
+	m_islandRecords.resize(records.size());
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		ContactIsland& island = m_islands[m_recordIslands[i]];
+		m_islandRecords[island.m_firstRecord + island.m_numRecords] = records[i];
+		island.m_numRecords++;
+		m_stats.m_largestIsland = std::max(m_stats.m_largestIsland, island.m_numRecords);
+	}
+	m_stats.m_numIslands = (int)m_islands.size();
+}
+
+void Octree::ResolveContactIsland(ContactIsland const& island)
+{
+	if (!island.m_isAwake) return;
+
+	for (int i = 0; i < island.m_numRecords; i++)
+	{
+		m_islandRecords[island.m_firstRecord + i]->Resolve();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// SPATIAL QUERIES
+
+static bool ClipRayToSlab(double start, double fwd, double slabMin, double slabMax, double& inout_enter, double& inout_exit)
+{
+	if (fwd == 0.0)
+	{
+		return start >= slabMin && start <= slabMax;
+	}
+	double t0 = (slabMin - start) / fwd;
+	double t1 = (slabMax - start) / fwd;
+	if (t0 > t1) std::swap(t0, t1);
+	inout_enter = DoubleMax(inout_enter, t0);
+	inout_exit = DoubleMin(inout_exit, t1);
+	return inout_enter <= inout_exit;
+}
+
+static bool GetRayEnterDistance(OctreeRay const& ray, double maxDist, DoubleAABB3 const& box, double& out_enterDist)
+{
+	double enter = 0.0;
+	double exit = maxDist;
+	if (!ClipRayToSlab(ray.m_startPos.x, ray.m_fwdNormal.x, box.m_mins.x, box.m_maxs.x, enter, exit)) return false;
+	if (!ClipRayToSlab(ray.m_startPos.y, ray.m_fwdNormal.y, box.m_mins.y, box.m_maxs.y, enter, exit)) return false;
+	if (!ClipRayToSlab(ray.m_startPos.z, ray.m_fwdNormal.z, box.m_mins.z, box.m_maxs.z, enter, exit)) return false;
+	out_enterDist = enter;
+	return true;
+}
+
+OctreeRaycastResult Octree::Raycast(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, unsigned int categoryMask) const
+{
+	OctreeRay ray = { startPos, fwdNormal, maxDist, categoryMask };
+	OctreeRaycastResult result;
+	result.m_rayStartPos = startPos;
+	result.m_rayFwdNormal = fwdNormal;
+	result.m_rayMaxLength = maxDist;
+	RaycastNode(OCTREE_ROOT, ray, result, false);
+	return result;
+}
 
-			tmp.pop_back();
+OctreeRaycastResult Octree::RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, unsigned int categoryMask) const
+{
+	OctreeRay ray = { startPos, fwdNormal, maxDist, categoryMask };
+	OctreeRaycastResult result;
+	result.m_rayStartPos = startPos;
+	result.m_rayFwdNormal = fwdNormal;
+	result.m_rayMaxLength = maxDist;
+	RaycastNode(OCTREE_ROOT, ray, result, true);
+	return result;
+}
+
+void Octree::RaycastBatch(std::vector<OctreeRay> const& rays, std::vector<OctreeRaycastResult>& out_results) const
+{
+	out_results.resize(rays.size());
+	for (size_t i = 0; i < rays.size(); i++)
+	{
+		OctreeRaycastResult& result = out_results[i];
+		result = OctreeRaycastResult();
+		result.m_rayStartPos = rays[i].m_startPos;
+		result.m_rayFwdNormal = rays[i].m_fwdNormal;
+		result.m_rayMaxLength = rays[i].m_maxDist;
+		RaycastNode(OCTREE_ROOT, rays[i], result, false);
+	}
+}
+
+// Objects sit in the smallest node that fully contains them, so nothing inside a node can be hit
+// closer than the ray's entry into that node. Children are visited front to back and skipped once
+// the best hit so far is nearer than their entry point.
+void Octree::RaycastNode(int nodeIndex, OctreeRay const& ray, OctreeRaycastResult& inout_best, bool stopAtFirstHit) const
+{
+	OctreeNode const& node = m_nodes[nodeIndex];
+
+	double bestDist = inout_best.m_didImpact ? (double)inout_best.m_impactDist : (double)ray.m_maxDist;
+	double enterDist = 0.0;
+	if (!GetRayEnterDistance(ray, bestDist, node.m_region, enterDist)) return;
+
+	for (int slot = node.m_firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
+	{
+		GameObject* obj = m_objectSlots[slot].m_object;
+		if ((obj->m_collisionCategory & ray.m_categoryMask) == 0) continue;
+
+		double objEnterDist = 0.0;
+		if (!GetRayEnterDistance(ray, bestDist, obj->m_bounds, objEnterDist)) continue;
+
+		RaycastResult3D hit = obj->RaycastVsObject(ray.m_startPos, ray.m_fwdNormal, (float)bestDist);
+		if (hit.m_didImpact && hit.m_impactDist <= bestDist)
+		{
+			static_cast<RaycastResult3D&>(inout_best) = hit;
+			inout_best.m_rayMaxLength = ray.m_maxDist;
+			inout_best.m_hitObject = obj;
+			bestDist = hit.m_impactDist;
+			if (stopAtFirstHit) return;
+		}
+	}
+
+	if (!node.HasChildren()) return;
+
+	int childOrder[8];
+	double childEnterDist[8];
+	int numChildren = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		if ((node.m_activeNodes & (1 << i)) == 0) continue;
+
+		double childDist = 0.0;
+		if (!GetRayEnterDistance(ray, bestDist, m_nodes[node.m_firstChild + i].m_region, childDist)) continue;
+
+		int order = numChildren++;
+		while (order > 0 && childEnterDist[order - 1] > childDist)
+		{
+			childOrder[order] = childOrder[order - 1];
+			childEnterDist[order] = childEnterDist[order - 1];
+			order--;
 		}
+		childOrder[order] = i;
+		childEnterDist[order] = childDist;
 	}
 
-	for (GameObject* obj : m_objects)
+	for (int i = 0; i < numChildren; i++)
+	{
+		if (inout_best.m_didImpact && childEnterDist[i] > inout_best.m_impactDist) break;
+		RaycastNode(node.m_firstChild + childOrder[i], ray, inout_best, stopAtFirstHit);
+		if (stopAtFirstHit && inout_best.m_didImpact) return;
+	}
+}
+
+void Octree::QuerySphere(DoubleVec3 const& center, double radius, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const
+{
+	QuerySphereNode(OCTREE_ROOT, center, radius, out_objects, categoryMask);
+}
+
+void Octree::QueryAABB(DoubleAABB3 const& box, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const
+{
+	QueryAABBNode(OCTREE_ROOT, box, out_objects, categoryMask);
+}
+
+void Octree::QuerySphereNode(int nodeIndex, DoubleVec3 const& center, double radius, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const
+{
+	OctreeNode const& node = m_nodes[nodeIndex];
+	double radiusSquared = radius * radius;
+	if ((node.m_region.GetNearestPoint(center) - center).GetLengthSquared() > radiusSquared) return;
+
+	for (int slot = node.m_firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
 	{
-		parentObj.push_back(obj);
+		GameObject* obj = m_objectSlots[slot].m_object;
+		if ((obj->m_collisionCategory & categoryMask) == 0) continue;
+		if ((obj->m_bounds.GetNearestPoint(center) - center).GetLengthSquared() > radiusSquared) continue;
+		out_objects.push_back(obj);
 	}
 
-	for (int flags = m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+	for (int flags = node.m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
 	{
 		if ((flags & 1) == 1)
 		{
-			if (m_childNode[index])
-			{
-				std::vector<CollisionRecord*> childCollisions = m_childNode[index]->GetIntersection(parentObj);
-				for (CollisionRecord* c : childCollisions)
-				{
-					collisions.push_back(c);
-				}
-			}
+			QuerySphereNode(node.m_firstChild + index, center, radius, out_objects, categoryMask);
 		}
 	}
+}
+
+void Octree::QueryAABBNode(int nodeIndex, DoubleAABB3 const& box, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const
+{
+	OctreeNode const& node = m_nodes[nodeIndex];
+	if (!DoAABBsOverlap3D_Double(node.m_region, box)) return;
 
-	return collisions;
+	for (int slot = node.m_firstObject; slot != -1; slot = m_objectSlots[slot].m_next)
+	{
+		GameObject* obj = m_objectSlots[slot].m_object;
+		if ((obj->m_collisionCategory & categoryMask) == 0) continue;
+		if (!DoAABBsOverlap3D_Double(obj->m_bounds, box)) continue;
+		out_objects.push_back(obj);
+	}
+
+	for (int flags = node.m_activeNodes, index = 0; flags > 0; flags >>= 1, index++)
+	{
+		if ((flags & 1) == 1)
+		{
+			QueryAABBNode(node.m_firstChild + index, box, out_objects, categoryMask);
+		}
+	}
 }
 
 CollisionRecord::CollisionRecord(Node* node, GameObject* object)
@@ -489,5 +879,37 @@ CollisionRecord::CollisionRecord(Node* node, GameObject* object)
 
 void CollisionRecord::Resolve()
 {
-	m_object->CollisionResolveVsRagdollNode(m_node);
+	m_hadContact = m_object->CollisionResolveVsRagdollNode(m_node);
+}
+
+int OctreeStats::GetNumNarrowphaseTests() const
+{
+	int total = 0;
+	for (int a = 0; a < NUM_COLLISION_SHAPES; a++)
+	{
+		for (int b = 0; b < NUM_COLLISION_SHAPES; b++)
+		{
+			total += m_narrowphaseTests[a][b];
+		}
+	}
+	return total;
+}
+
+std::string OctreeStats::ToString() const
+{
+	std::string text;
+	text += Stringf("Broadphase: %i candidates, %i filtered by mask, %i rejected by AABB\n", m_candidatePairs, m_pairsFilteredByMask, m_pairsRejectedByAABB);
+	text += Stringf("Narrowphase: %i tests, %i contacts\n", GetNumNarrowphaseTests(), m_contacts);
+	text += Stringf("Islands: %i (%i asleep), largest %i records\n", m_numIslands, m_sleepingIslands, m_largestIsland);
+	for (int a = 0; a < NUM_COLLISION_SHAPES; a++)
+	{
+		for (int b = 0; b < NUM_COLLISION_SHAPES; b++)
+		{
+			if (m_narrowphaseTests[a][b] == 0) continue;
+			text += Stringf("  %s vs %s: %i\n", GetCollisionShapeName((CollisionShape)a), GetCollisionShapeName((CollisionShape)b), m_narrowphaseTests[a][b]);
+		}
+	}
+	text += Stringf("Octree: %i nodes, %i leaves, depth %i, max %i objects per leaf\n", m_numNodes, m_numLeaves, m_treeDepth, m_maxObjectsPerLeaf);
+	text += Stringf("Re-insertions: %i, node changes: %i\n", m_reinsertions, m_nodeChanges);
+	return text;
 }
@@ -1,13 +1,22 @@
 #pragma once
 #include <vector>
-#include <deque>
+#include <cfloat>
+#include <string>
 #include "Engine/Math/AABB3.hpp"
 #include "Game/GameObject.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
 
 constexpr int LIFE_TIME = 64;
+constexpr int OCTREE_ROOT = 0;
+constexpr double OCTREE_MIN_SIZE = 1.0;
+constexpr int OCTREE_INITIAL_BLOCKS = 64;
+constexpr int CONTACT_PARALLEL_THRESHOLD = 64;	// below this many records a step, resolve serially
+constexpr int OCTREE_BOUNDS_GRAIN = 64;			// object slots per ParallelFor chunk when refreshing bounds
 
 struct Node;
+struct Octree;
+class Ragdoll;
 
 struct CollisionRecord
 {
@@ -15,55 +24,166 @@ struct CollisionRecord
 
 	Node* m_node = nullptr;
 	GameObject* m_object = nullptr;
+	bool m_hadContact = false;
 
 	void Resolve();
 };
 
-struct Octree
+//------------------------------------------------------------------------------------------------
+// Spatial queries walk the tree instead of every object, so their cost follows what the ray or
+// volume actually touches. Objects are filtered by CollisionCategory before any narrow test.
+struct OctreeRaycastResult : public RaycastResult3D
 {
-	Octree();
-	Octree(DoubleAABB3 region, std::vector<GameObject*> objects);
-	Octree(DoubleAABB3 region);
-	~Octree();
-	
-	DoubleAABB3 m_region;
-	std::vector<GameObject*> m_objects;
-	std::deque<GameObject*> m_pendingInsertion;
+	GameObject* m_hitObject = nullptr;
+};
 
-	Octree* m_childNode[8] = { nullptr }; ;
+struct OctreeRay
+{
+	Vec3 m_startPos;
+	Vec3 m_fwdNormal;
+	float m_maxDist = FLT_MAX;
+	unsigned int m_categoryMask = COLLISION_CATEGORY_ALL;
+};
 
-	unsigned char m_activeNodes = 0;
+//------------------------------------------------------------------------------------------------
+// Counters for the most recent Octree::Update step. Pair counters follow a candidate from the
+// traversal through the mask filter and AABB test to the narrowphase; tree counters are sampled
+// after pruning.
+struct OctreeStats
+{
+	int m_candidatePairs = 0;
+	int m_pairsFilteredByMask = 0;
+	int m_pairsRejectedByAABB = 0;
+	int m_narrowphaseTests[NUM_COLLISION_SHAPES][NUM_COLLISION_SHAPES] = {};
+	int m_contacts = 0;
+
+	int m_numIslands = 0;
+	int m_sleepingIslands = 0;
+	int m_largestIsland = 0;		// in records
+
+	int m_reinsertions = 0;
+	int m_nodeChanges = 0;
+
+	int m_numNodes = 0;
+	int m_numLeaves = 0;
+	int m_treeDepth = 0;
+	int m_maxObjectsPerLeaf = 0;
+
+	int GetNumNarrowphaseTests() const;
+	std::string ToString() const;
+};
 
-	const float MIN_SIZE = 1.f;
+//------------------------------------------------------------------------------------------------
+// Ragdolls joined through node-vs-node contacts, with every record that touches them. Constraints
+// never cross ragdolls, so an island owns everything its records write and can be solved on its own.
+// An island is asleep when every ragdoll in it is dead.
+struct ContactIsland
+{
+	int m_firstRecord = 0;			// into Octree::m_islandRecords
+	int m_numRecords = 0;
+	bool m_isAwake = false;
+};
+
+//------------------------------------------------------------------------------------------------
+// Nodes live in one pool owned by the tree and refer to each other by index. A node's children are
+// a block of 8 consecutive pool entries, allocated together and recycled through a free list.
+// Objects are kept in a singly linked list threaded through the tree's shared object slots.
+struct OctreeNode
+{
+	DoubleAABB3 m_region;
+
+	int m_parent = -1;
+	int m_firstChild = -1;
+	int m_firstObject = -1;
+	int m_numObjects = 0;
+	unsigned char m_activeNodes = 0;
 
 	int m_maxLifespan = LIFE_TIME;
-	int m_curLife = -1; 
+	int m_curLife = -1;
 	int m_layer = 0;
-	std::string m_name = "";
 
-	Octree* m_parent = nullptr;
-	bool m_isRoot = false;
+	bool HasChildren() const { return m_activeNodes != 0; }
+};
+
+struct OctreeObjectSlot
+{
+	GameObject* m_object = nullptr;
+	int m_next = -1;
+};
+
+struct Octree
+{
+	Octree(DoubleAABB3 region, std::vector<GameObject*> objects);
+	~Octree();
+
+	std::vector<OctreeNode> m_nodes;
+	std::vector<int> m_freeBlocks;
+
+	std::vector<OctreeObjectSlot> m_objectSlots;
+	int m_freeObjectSlot = -1;
+
+	std::vector<GameObject*> m_pendingInsertion;
 
 	bool bm_ready = false;
 	bool bm_built = false;
 
-	std::vector<Vertex_PCU> m_debugvertexes;
-	VertexBuffer* m_debugbuffer = nullptr;
-
-	void Init();
 	void Update();
 	void Render() const;
-	bool Insert(GameObject* object);
-	void BuildTree();
 	void UpdateTree();
-	void ResetTreeObjects(std::vector<GameObject*> objects);
-	bool HasChildren() const;
-	Octree* CreateNode(DoubleAABB3 region, std::vector<GameObject*> objects);
-	Octree* CreateNode(DoubleAABB3 region, GameObject* object);
 
-	void UpdateTreeObjects(Octree* tree);
-	void PruneDeadBranches(Octree* tree);
+	// Update() runs these in order; each also stands alone as a stage of a step graph
+	void RefitObjects();
+	void FindCollisionPairs();
+	void ResolveCollisionPairs();
+	void Maintain();
+
+	void ResetTreeObjects(std::vector<GameObject*> objects);
+	int GetNumActiveNodes() const;
+	OctreeStats const& GetStats() const;
+
+	OctreeRaycastResult Raycast(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, unsigned int categoryMask = COLLISION_CATEGORY_ALL) const;
+	OctreeRaycastResult RaycastAny(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, unsigned int categoryMask = COLLISION_CATEGORY_ALL) const;
+	void RaycastBatch(std::vector<OctreeRay> const& rays, std::vector<OctreeRaycastResult>& out_results) const;
+	void QuerySphere(DoubleVec3 const& center, double radius, std::vector<GameObject*>& out_objects, unsigned int categoryMask = COLLISION_CATEGORY_ALL) const;
+	void QueryAABB(DoubleAABB3 const& box, std::vector<GameObject*>& out_objects, unsigned int categoryMask = COLLISION_CATEGORY_ALL) const;
 private:
 
-	std::vector<CollisionRecord*> GetIntersection(std::vector<GameObject*> parentObj);
-};
\ No newline at end of file
+	bool Insert(int nodeIndex, GameObject* object);
+	void BuildTree(int nodeIndex);
+	void RefreshObjectBounds();
+	void UpdateTreeObjects(int nodeIndex);
+	void PruneDeadBranches(int nodeIndex);
+
+	int ActivateChild(int nodeIndex, int octant);
+	void DeactivateChild(int nodeIndex, int octant);
+	void AddObject(int nodeIndex, GameObject* object);
+	void LinkObjectSlot(int nodeIndex, int slot);
+	void RemoveObject(int nodeIndex, GameObject* object);
+
+	void AddVertsForNode(int nodeIndex, std::vector<Vertex_PCU>& verts) const;
+	void GetIntersection(int nodeIndex, std::vector<CollisionRecord*>& out_records);
+	void TestPair(GameObject* objA, GameObject* objB, std::vector<CollisionRecord*>& out_records);
+	void GatherTreeStats(int nodeIndex);
+	void ResolveCollisions(std::vector<CollisionRecord*> const& records);
+	void BuildContactIslands(std::vector<CollisionRecord*> const& records);
+	void ResolveContactIsland(ContactIsland const& island);
+
+	void RaycastNode(int nodeIndex, OctreeRay const& ray, OctreeRaycastResult& inout_best, bool stopAtFirstHit) const;
+	void QuerySphereNode(int nodeIndex, DoubleVec3 const& center, double radius, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const;
+	void QueryAABBNode(int nodeIndex, DoubleAABB3 const& box, std::vector<GameObject*>& out_objects, unsigned int categoryMask) const;
+
+	std::vector<GameObject*> m_movedObjects;		// stack shared by UpdateTreeObjects' recursion
+	std::vector<GameObject*> m_ancestorObjects;		// stack shared by GetIntersection's recursion
+
+	OctreeStats m_stats;
+	std::vector<CollisionRecord*> m_stepRecords;
+	bool m_isStepSkipped = false;
+
+	// Rebuilt every step by BuildContactIslands
+	std::vector<ContactIsland> m_islands;
+	std::vector<CollisionRecord*> m_islandRecords;		// grouped by island, in step order within each
+	std::vector<int> m_islandParents;					// union-find over the ragdolls touched this step
+	std::vector<int> m_recordIslands;
+	std::vector<Ragdoll*> m_islandRagdolls;				// indexed by Ragdoll::m_islandIndex
+	std::vector<int> m_rootIslands;
+};
@@ -1,8 +1,9 @@
 #include "Game/Ragdoll.hpp"
 #include "Game/Game.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 Ragdoll::Ragdoll(Game* game, DoubleMat44 transform, float deadTimer, VerletConfig config, int debugType, Rgba8 nodeColor, Rgba8 constraintColor)
-	:m_game(game), m_transform(transform), m_deadTimer(deadTimer), m_config(config), m_nodeColor(nodeColor), m_constraintColor(constraintColor)
+	:m_game(game), m_transform(transform), m_deadTimer(deadTimer), m_config(config), m_nodeColor(nodeColor), m_constraintColor(constraintColor), m_archetype(debugType)
 {
 	switch (debugType)
 	{
@@ -22,7 +23,12 @@ Ragdoll::Ragdoll(Game* game, DoubleMat44 transform, float deadTimer, VerletConfi
 		break;
 	}
 
+	BuildCollisionFilter();
+
 	m_brokenLimit = g_theRNG->RollRandomIntInRange(3, 10);
+
+	PublishRenderSnapshot(0);
+	PublishRenderSnapshot(1);
 }
 
 Ragdoll::~Ragdoll()
@@ -38,6 +44,8 @@ Ragdoll::~Ragdoll()
 		delete c;
 		c = nullptr;
 	}
+
+	ReleaseBrokenConstraints();
 }
 
 DoubleMat44 Ragdoll::GetRootTransform() const
@@ -83,14 +91,190 @@ void Ragdoll::SolveOneIteration(float deltaTime)
 
 void Ragdoll::Render() const
 {
+	RagdollRenderSnapshot const& snapshot = m_renderSnapshots[m_game->m_renderSnapshotIndex];
+	double alpha = m_game->m_renderAlpha;
+	for (size_t i = 0; i < snapshot.m_nodes.size(); i++)
+	{
+		m_nodes[i]->Render(snapshot.m_nodes[i], alpha);
+	}
+	for (auto& c : snapshot.m_constraints)
+	{
+		c.m_constraint->Render(Interpolate(c.m_previousPosition, c.m_position, alpha));
+	}
+}
+
+void Ragdoll::PublishRenderSnapshot(int buffer)
+{
+	RagdollRenderSnapshot& snapshot = m_renderSnapshots[buffer];
+
+	snapshot.m_nodes.resize(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); i++)
+	{
+		NodeRenderState& state = m_nodes[i]->m_renderState;
+		state.m_previousPosition = state.m_position;
+		state.m_previousOrientation = state.m_orientation;
+		state.m_position = m_nodes[i]->m_position;
+		state.m_orientation = m_nodes[i]->m_orientation;
+		snapshot.m_nodes[i] = state;
+	}
+
+	snapshot.m_constraints.resize(m_constraints.size());
+	for (size_t i = 0; i < m_constraints.size(); i++)
+	{
+		Constraint const* c = m_constraints[i];
+		NodeRenderState const& stateA = c->nA->m_renderState;
+		NodeRenderState const& stateB = c->nB->m_renderState;
+		snapshot.m_constraints[i].m_constraint = c;
+		snapshot.m_constraints[i].m_previousPosition = (stateA.m_previousPosition + stateB.m_previousPosition) * 0.5;
+		snapshot.m_constraints[i].m_position = (stateA.m_position + stateB.m_position) * 0.5;
+	}
+}
+
+void Ragdoll::ReleaseBrokenConstraints()
+{
+	for (auto& c : m_brokenConstraints)
+	{
+		delete c;
+	}
+	m_brokenConstraints.clear();
+}
+
+// The archetype, spawn transform and colors lead, so CreateFromState can build the ragdoll before parsing the rest
+void Ragdoll::AppendState(BufferWriter& writer) const
+{
+	writer.AppendInt32(m_archetype);
+	writer.AppendDoubleMat44(m_transform);
+	writer.AppendRgba8(m_nodeColor);
+	writer.AppendRgba8(m_constraintColor);
+
+	writer.AppendUint32((unsigned int)m_constraints.size());
+	for (auto& c : m_constraints)
+	{
+		writer.AppendInt32(c->m_constraintIndex);
+	}
+
+	writer.AppendUint32(m_spawnID);
+	writer.AppendDoubleVec3(m_config.gravAccel);
+	writer.AppendInt32(m_config.iterations);
+	writer.AppendDouble(m_config.airFriction);
+	writer.AppendBool(m_selfCollision);
+	writer.AppendBool(m_isBreakable);
+	writer.AppendInt32(m_brokenLimit);
+	writer.AppendInt32(m_brokenCount);
+	writer.AppendFloat(m_timeSinceSpawn);
+	writer.AppendBool(m_isDead);
+	writer.AppendDouble(m_totalEnergy);
+	writer.AppendFloat(m_deadTimer);
+	writer.AppendBool(DEBUG_solveConstraintWithFixedIteration);
+	writer.AppendDouble(DEBUG_maxVelocity);
+	writer.AppendDouble(DEBUG_posFixRate);
+	writer.AppendDouble(DEBUG_angleFixRate);
+
+	writer.AppendUint32((unsigned int)m_nodes.size());
 	for (auto& n : m_nodes)
 	{
-		n->Render();
+		writer.AppendBool(n->m_isResting);
+		writer.AppendBool(n->m_previousResting);
+		writer.AppendDoubleVec3(n->m_position);
+		writer.AppendDoubleVec3(n->m_velocity);
+		writer.AppendDoubleVec3(n->m_acceleration);
+		writer.AppendDoubleQuaternion(n->m_orientation);
+		writer.AppendDoubleVec3(n->m_angularVelocity);
+		writer.AppendDoubleVec3(n->m_lastFrameTorque);
+		writer.AppendDoubleVec3(n->m_torque);
+		writer.AppendDoubleVec3(n->m_netForce);
 	}
+}
+
+bool Ragdoll::ParseState(BufferParser& parser)
+{
+	if (parser.ParseInt32() != m_archetype) return false;
+	DoubleMat44 transform = parser.ParseDoubleMat44();
+	Rgba8 nodeColor = parser.ParseRgba8();
+	Rgba8 constraintColor = parser.ParseRgba8();
+
+	// Constraints that broke after the state was saved cannot be brought back here
+	int maxConstraintIndex = -1;
 	for (auto& c : m_constraints)
 	{
-		c->Render();
+		maxConstraintIndex = (c->m_constraintIndex > maxConstraintIndex) ? c->m_constraintIndex : maxConstraintIndex;
 	}
+	std::vector<bool> isKept(maxConstraintIndex + 1, false);
+	unsigned int numConstraints = parser.ParseUint32();
+	for (unsigned int i = 0; i < numConstraints; i++)
+	{
+		int constraintIndex = parser.ParseInt32();
+		auto found = std::find_if(m_constraints.begin(), m_constraints.end(), [constraintIndex](Constraint* c) { return c->m_constraintIndex == constraintIndex; });
+		if (found == m_constraints.end()) return false;
+		isKept[constraintIndex] = true;
+	}
+	for (size_t i = 0; i < m_constraints.size();)
+	{
+		if (isKept[m_constraints[i]->m_constraintIndex])
+		{
+			i++;
+			continue;
+		}
+		m_brokenConstraints.push_back(m_constraints[i]);
+		m_constraints.erase(m_constraints.begin() + i);
+	}
+
+	m_transform = transform;
+	m_nodeColor = nodeColor;
+	m_constraintColor = constraintColor;
+
+	m_spawnID = parser.ParseUint32();
+	m_config.gravAccel = parser.ParseDoubleVec3();
+	m_config.iterations = parser.ParseInt32();
+	m_config.airFriction = parser.ParseDouble();
+	m_selfCollision = parser.ParseBool();
+	m_isBreakable = parser.ParseBool();
+	m_brokenLimit = parser.ParseInt32();
+	m_brokenCount = parser.ParseInt32();
+	m_timeSinceSpawn = parser.ParseFloat();
+	m_isDead = parser.ParseBool();
+	m_totalEnergy = parser.ParseDouble();
+	m_deadTimer = parser.ParseFloat();
+	DEBUG_solveConstraintWithFixedIteration = parser.ParseBool();
+	DEBUG_maxVelocity = parser.ParseDouble();
+	DEBUG_posFixRate = parser.ParseDouble();
+	DEBUG_angleFixRate = parser.ParseDouble();
+
+	unsigned int numNodes = parser.ParseUint32();
+	GUARANTEE_OR_DIE(numNodes == m_nodes.size(), Stringf("World state has %u nodes for a ragdoll with %u", numNodes, (unsigned int)m_nodes.size()));
+	for (auto& n : m_nodes)
+	{
+		n->m_isResting = parser.ParseBool();
+		n->m_previousResting = parser.ParseBool();
+		n->m_position = parser.ParseDoubleVec3();
+		n->m_velocity = parser.ParseDoubleVec3();
+		n->m_acceleration = parser.ParseDoubleVec3();
+		n->m_orientation = parser.ParseDoubleQuaternion();
+		n->m_angularVelocity = parser.ParseDoubleVec3();
+		n->m_lastFrameTorque = parser.ParseDoubleVec3();
+		n->m_torque = parser.ParseDoubleVec3();
+		n->m_netForce = parser.ParseDoubleVec3();
+	}
+
+	// Nothing to interpolate from across a restore
+	PublishRenderSnapshot(0);
+	PublishRenderSnapshot(1);
+	return true;
+}
+
+Ragdoll* Ragdoll::CreateFromState(Game* game, BufferParser& parser)
+{
+	size_t start = parser.GetCurReadPosition();
+	int archetype = parser.ParseInt32();
+	DoubleMat44 transform = parser.ParseDoubleMat44();
+	Rgba8 nodeColor = parser.ParseRgba8();
+	Rgba8 constraintColor = parser.ParseRgba8();
+	parser.SetCurReadPosition(start);
+
+	Ragdoll* ragdoll = new Ragdoll(game, transform, 5.f, VerletConfig(), archetype, nodeColor, constraintColor);
+	bool isRestored = ragdoll->ParseState(parser);
+	GUARANTEE_OR_DIE(isRestored, "A new ragdoll has every constraint, so its world state always restores");
+	return ragdoll;
 }
 
 void Ragdoll::IntegratePosition_VelocityVerlet(float deltaTime, double f)
@@ -244,7 +428,7 @@ void Ragdoll::BreakNodeFromRagdoll(Node* n)
 		if (c->nB == n)
 		{
 			auto find = std::find(m_constraints.begin(), m_constraints.end(), c);
-			delete c;
+			m_brokenConstraints.push_back(c);
 			m_constraints.erase(find);
 			m_brokenCount++;
 			return;
@@ -252,6 +436,13 @@ void Ragdoll::BreakNodeFromRagdoll(Node* n)
 	}
 }
 
+bool Ragdoll::CanNodesCollide(int nodeIndexA, int nodeIndexB) const
+{
+	if (!m_selfCollision) return false;
+	if (!m_collisionFilter) return true;
+	return !m_collisionFilter->IsPairIgnored(nodeIndexA, nodeIndexB);
+}
+
 std::vector<Node*> Ragdoll::GetNodeList() const
 {
 	return m_nodes;
@@ -290,14 +481,19 @@ std::string Ragdoll::GetConstraintName(int index) const
 	return m_constraints[index]->nA->m_name + " to " + m_constraints[index]->nB->m_name;
 }
 
-void Ragdoll::CheckShouldItBeDead()
+double Ragdoll::GetEnergy() const
 {
-	double thisFrameEnergy = 0;
-
+	double energy = 0;
 	for (auto* n : m_nodes)
 	{
-		thisFrameEnergy += GetTotalEnergy(n->m_velocity, n->m_mass, m_config.gravAccel, n->m_position.z);
+		energy += GetTotalEnergy(n->m_velocity, n->m_mass, m_config.gravAccel, n->m_position.z);
 	}
+	return energy;
+}
+
+void Ragdoll::CheckShouldItBeDead()
+{
+	double thisFrameEnergy = GetEnergy();
 
 	m_isDead |= abs(m_totalEnergy - thisFrameEnergy) <= 50;
 
@@ -600,6 +796,41 @@ void Ragdoll::CreateDebugNodes()
 	//	DoubleVec3(90, 120, 30));
 }
 
+void Ragdoll::BuildCollisionFilter()
+{
+	GUARANTEE_OR_DIE(m_nodes.size() <= MAX_RAGDOLL_NODES, "Ragdoll has more nodes than the collision filter supports");
+
+	for (int i = 0; i < (int)m_nodes.size(); i++)
+	{
+		m_nodes[i]->m_nodeIndex = i;
+		m_nodes[i]->m_collisionCategory = COLLISION_CATEGORY_RAGDOLL;
+	}
+
+	static std::map<int, RagdollCollisionFilter> s_archetypeFilters;
+
+	auto found = s_archetypeFilters.find(m_archetype);
+	if (found != s_archetypeFilters.end())
+	{
+		m_collisionFilter = &found->second;
+		return;
+	}
+
+	RagdollCollisionFilter& filter = s_archetypeFilters[m_archetype];
+	for (auto& n : m_nodes)
+	{
+		if (n->m_parent)
+		{
+			filter.IgnorePair(n->m_nodeIndex, n->m_parent->m_nodeIndex);
+		}
+	}
+	for (auto& c : m_constraints)
+	{
+		filter.IgnorePair(c->nA->m_nodeIndex, c->nB->m_nodeIndex);
+	}
+
+	m_collisionFilter = &filter;
+}
+
 Node* Ragdoll::CreateRootNode(std::string name, DoubleVec3 offsetPositionToParent, double radius, double mass)
 {
 	auto newNode = new SphereNode(m_game, this, name, nullptr, m_transform, radius, mass, m_nodeColor);
@@ -650,6 +881,7 @@ Constraint* Ragdoll::CreateConstraint(Node* nA, Node* nB,
 {
 	Constraint* newConstraint = new Constraint(m_game, nA, nB, pinA, pinB, targetDistance, minAngle, maxAngle, m_constraintColor);
 	newConstraint->m_ragdoll = this;
+	newConstraint->m_constraintIndex = (int)m_constraints.size();
 	m_constraints.push_back(newConstraint);
 	return newConstraint;
 }
@@ -665,7 +897,29 @@ Node::Node(Game* game, Ragdoll* ragdoll, std::string name, Node* parent, DoubleM
 }
 
 
+DoubleMat44 NodeRenderState::GetModelMatrix(double alpha) const
+{
+	DoubleQuaternion orientation = DoubleQuaternion::NLerp(m_previousOrientation, m_orientation, alpha);
+	return orientation.GetConjugated().GetMatrix(GetPosition(alpha));
+}
+
+DoubleVec3 NodeRenderState::GetPosition(double alpha) const
+{
+	return Interpolate(m_previousPosition, m_position, alpha);
+}
+
 void Node::Render() const
+{
+	NodeRenderState state;
+	state.m_previousPosition = m_position;
+	state.m_previousOrientation = m_orientation;
+	state.m_position = m_position;
+	state.m_orientation = m_orientation;
+	Render(state);
+}
+
+// Debug draw reads live node state too, which is only safe because it turns off overlapped stepping
+void Node::Render(NodeRenderState const& state, double alpha) const
 {
 	g_theRenderer->SetDepthStencilMode(DepthMode::ENABLED);
 	g_theRenderer->SetBlendMode(BlendMode::ALPHA);
@@ -675,12 +929,13 @@ void Node::Render() const
 	g_theRenderer->BindTexture(nullptr, 0);
 	g_theRenderer->BindTexture(nullptr, 1);
 	g_theRenderer->BindTexture(nullptr, 2);
-	g_theRenderer->SetModelConstants(GetModelMatrix(), m_color);
+	g_theRenderer->SetModelConstants(state.GetModelMatrix(alpha), m_color);
 	g_theRenderer->DrawIndexedBuffer(m_vbuffer, m_ibuffer, m_indexes.size(), 0, VertexType::Vertex_PCUTBN);
 
 	if (m_game->DEBUG_DebugDraw)
 	{
 		std::vector<Vertex_PCU> debug;
+		DoubleVec3 position = state.GetPosition(alpha);
 
 		if (m_game->DEBUG_DebugDrawOctree)
 		{
@@ -697,12 +952,12 @@ void Node::Render() const
 			g_theRenderer->BindTexture(nullptr, 0);
 			g_theRenderer->BindTexture(nullptr, 1);
 			g_theRenderer->BindTexture(nullptr, 2);
-			g_theRenderer->SetModelConstants(GetModelMatrix());
+			g_theRenderer->SetModelConstants(state.GetModelMatrix(alpha));
 			g_theRenderer->DrawVertexBuffer(m_debugbuffer, m_debugvertexes.size());
 
 			if (m_parent)
 			{
-				AddVertsForLine3D(debug, m_position, m_parent->m_position, 0.01f, Rgba8::COLOR_DARK_X2_GRAY, 4);
+				AddVertsForLine3D(debug, position, m_parent->m_position, 0.01f, Rgba8::COLOR_DARK_X2_GRAY, 4);
 			}
 			g_theRenderer->BindShader(nullptr);
 			g_theRenderer->SetModelConstants();
@@ -712,8 +967,8 @@ void Node::Render() const
 
 		if (m_game->DEBUG_DebugDrawVel)
 		{
-			AddVertsForArrow3D(debug, m_position, m_position + m_velocity, 0.025f, Rgba8::COLOR_YELLOW);
-			AddVertsForArrow3D(debug, m_position, m_position + m_angularVelocity, 0.025f, Rgba8(207, 159, 255));
+			AddVertsForArrow3D(debug, position, position + m_velocity, 0.025f, Rgba8::COLOR_YELLOW);
+			AddVertsForArrow3D(debug, position, position + m_angularVelocity, 0.025f, Rgba8(207, 159, 255));
 			g_theRenderer->BindShader(nullptr);
 			g_theRenderer->SetModelConstants();
 			g_theRenderer->DrawVertexArray(debug.size(), debug.data(), true);
@@ -954,9 +1209,14 @@ std::string Constraint::GetName() const
 }
 
 void Constraint::Render() const
+{
+	Render(nA->m_position + (nB->m_position - nA->m_position) * 0.5);
+}
+
+void Constraint::Render(DoubleVec3 const& position) const
 {
 	Mat44 mat;
-	mat.SetTranslation3D(nA->m_position + (nB->m_position - nA->m_position) * 0.5);
+	mat.SetTranslation3D(position);
 
 	g_theRenderer->SetDepthStencilMode(DepthMode::ENABLED);
 	g_theRenderer->SetBlendMode(BlendMode::ALPHA);
@@ -1089,55 +1349,6 @@ void PushRagdollOutOfCapsule3D_Double(Ragdoll* ragdoll, DoubleCapsule3& capsule)
 	}
 }
 
-RaycastRagdollResult3D MouseRaycastVsRagdollNode(Camera* camera, Vec2 cursorPosition, Ragdoll* ragdoll)
-{
-	RaycastRagdollResult3D finalResult;
-
-	for (int i = 0; i < ragdoll->GetNodeList().size(); i++)
-	{
-		Node* n = ragdoll->GetNodeList()[i];
-		RaycastResult3D resultNode;
-
-		if (n->IsSphere())
-		{
-			resultNode = MouseRaycastVsSphere3D(camera, cursorPosition, n->m_position, (float)n->m_radius);
-		}
-		else
-		{
-			double halfLength = n->GetHalfLength() - n->m_radius;
-			DoubleVec3 axis = n->GetAxis().GetNormalized();
-			DoubleCapsule3 capsule = DoubleCapsule3(n->m_position - axis * halfLength, n->m_position + axis * halfLength, (float)n->m_radius);
-			resultNode = MouseRaycastVsCapsule3D(camera, cursorPosition, capsule);
-		}
-
-		finalResult.m_rayStartPos = resultNode.m_rayStartPos;
-		finalResult.m_rayFwdNormal = resultNode.m_rayFwdNormal;
-		finalResult.m_rayMaxLength = resultNode.m_rayMaxLength;
-
-		if (resultNode.m_didImpact)
-		{
-			finalResult.m_didImpact = resultNode.m_didImpact;
-			finalResult.m_impactPos = resultNode.m_impactPos;
-			finalResult.m_impactNormal = resultNode.m_impactNormal;
-			finalResult.m_impactDist = resultNode.m_impactDist;
-
-			finalResult.m_hitNode = n;
-			for (size_t j = 0; j < ragdoll->GetConstraints().size(); j++)
-			{
-				Constraint* c = ragdoll->GetConstraints()[j];
-				if (c->nA == n || c->nB == n)
-				{
-					finalResult.m_hitConstraints.push_back(c);
-				}
-			}
-			break;
-		}
-	}
-
-	return finalResult;
-}
-
-
 void NodeCollisionSolver::ResolveCollision(NodeCollisionPoint& col)
 {
 	// Skip if no actual collision
@@ -1375,6 +1586,7 @@ SphereNode::SphereNode(Game* game, Ragdoll* ragdoll, std::string name, Node* par
 	:Node(game, ragdoll, name, parent, transform, radius, mass)
 {
 	m_isSphere = true;
+	m_collisionShape = COLLISION_SHAPE_SPHERE_NODE;
 	m_color = debugColor;
 
 	if (parent)
@@ -1516,14 +1728,6 @@ bool SphereNode::NodeOverlapFixedCapsule_Double(DoubleCapsule3 const& capsule)
 bool SphereNode::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (m_ragdoll->m_isDead)   return false;
-	if (m_parent && m_parent == node)
-	{
-		return false;
-	}
-	if (node->m_parent && node->m_parent == this)
-	{
-		return false;
-	}
 
 	CollisionInfo info;
 	NodeCollisionPoint col;
@@ -1586,10 +1790,16 @@ DoubleAABB3 SphereNode::GetBoundingBox() const
 	return DoubleAABB3(Min, Max);
 }
 
+RaycastResult3D SphereNode::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
+{
+	return RaycastVsSphere3D(startPos, fwdNormal, maxDist, m_position, (float)m_radius);
+}
+
 CapsuleNode::CapsuleNode(Game* game, Ragdoll* ragdoll, std::string name, Node* parent, DoubleMat44 transform, double radius, DoubleVec3 axis, double halfLength, double mass, Rgba8 debugColor)
 	:Node(game, ragdoll, name, parent, transform, radius, mass)
 {
 	m_isSphere = false;
+	m_collisionShape = COLLISION_SHAPE_CAPSULE_NODE;
 
 	m_capsuleHalfAxisLength = halfLength;
 	m_capsuleAxis = axis.GetNormalized();
@@ -1791,14 +2001,6 @@ bool CapsuleNode::NodeOverlapFixedCapsule_Double(DoubleCapsule3 const& capsule)
 bool CapsuleNode::CollisionResolveVsRagdollNode(Node* node)
 {
 	if (m_ragdoll->m_isDead)   return false;
-	if (m_parent && m_parent == node)
-	{
-		return false;
-	}
-	if (node->m_parent && node->m_parent == this)
-	{
-		return false;
-	}
 
 	CollisionInfo info;
 	NodeCollisionPoint col;
@@ -1870,9 +2072,22 @@ DoubleAABB3 CapsuleNode::GetBoundingBox() const
 	return capsule.GetBoundingBox();
 }
 
-void RagdollPhysicsJob::Execute()
+RaycastResult3D CapsuleNode::RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const
 {
-	if (m_ragdoll->m_isDead) return;
+	DoubleVec3 axis = GetAxis().GetNormalized();
+	DoubleCapsule3 capsule = DoubleCapsule3(m_position - axis * m_capsuleHalfAxisLength, m_position + axis * m_capsuleHalfAxisLength, m_radius);
+	return RaycastVsCapsule3D(startPos, fwdNormal, maxDist, capsule);
+}
 
-	m_ragdoll->SolveOneIteration(m_timeStep);
+void RagdollCollisionFilter::IgnorePair(int nodeA, int nodeB)
+{
+	if (nodeA < 0 || nodeB < 0) return;
+	m_ignoreRows[nodeA] |= (1ull << nodeB);
+	m_ignoreRows[nodeB] |= (1ull << nodeA);
 }
+
+bool RagdollCollisionFilter::IsPairIgnored(int nodeA, int nodeB) const
+{
+	if (nodeA < 0 || nodeB < 0) return false;
+	return (m_ignoreRows[nodeA] & (1ull << nodeB)) != 0;
+}
\ No newline at end of file
@@ -19,6 +19,10 @@ struct Object;
 struct Node;
 struct Constraint;
 class Ragdoll;
+class BufferWriter;
+class BufferParser;
+
+constexpr int MAX_RAGDOLL_NODES = 64;
 
 struct VerletConfig
 {
@@ -33,6 +37,16 @@ struct RaycastRagdollResult3D : public RaycastResult3D
 	std::vector<Constraint*> m_hitConstraints;
 };
 
+// Node pairs of one ragdoll archetype that never collide with each other (parent/child joints).
+// Built once per archetype and shared by every ragdoll spawned from it.
+struct RagdollCollisionFilter
+{
+	void IgnorePair(int nodeA, int nodeB);
+	bool IsPairIgnored(int nodeA, int nodeB) const;
+
+	uint64_t m_ignoreRows[MAX_RAGDOLL_NODES] = {};
+};
+
 struct NodeCollisionPoint
 {
 	DoubleVec3 position;
@@ -54,6 +68,32 @@ public:
 	void ApplyImpulseCollision(Node* bodyA, Node* bodyB, const DoubleVec3& impulse, const DoubleVec3& rA, const DoubleVec3& rB);
 };
 
+// What the renderer needs of one node, copied out at the end of a fixed step. It keeps the previous
+// step too, so a frame can be drawn between the two by the leftover time debt
+struct NodeRenderState
+{
+	DoubleVec3 m_previousPosition;
+	DoubleQuaternion m_previousOrientation;
+	DoubleVec3 m_position;
+	DoubleQuaternion m_orientation;
+
+	DoubleMat44 GetModelMatrix(double alpha = 1.0) const;
+	DoubleVec3 GetPosition(double alpha = 1.0) const;
+};
+
+struct ConstraintRenderState
+{
+	Constraint const* m_constraint = nullptr;
+	DoubleVec3 m_previousPosition;
+	DoubleVec3 m_position;
+};
+
+struct RagdollRenderSnapshot
+{
+	std::vector<NodeRenderState> m_nodes;
+	std::vector<ConstraintRenderState> m_constraints;
+};
+
 struct VelocityLessState
 {
 	VelocityLessState() = default;
@@ -78,15 +118,19 @@ struct Node : public GameObject
 	std::string m_name;
 	Node* m_parent = nullptr;
 	Ragdoll* m_ragdoll = nullptr;
+	int m_nodeIndex = -1;
 
 	double m_radius = 0.25;
 	bool m_previousResting = false;
 	bool m_isSphere = true;
 	DoubleVec3 m_offsetToParent = DoubleVec3::ZERO;
 
+	NodeRenderState m_renderState;		// last published, owned by the simulation side
+
 public:
 
 	void Render() const override;
+	void Render(NodeRenderState const& state, double alpha = 1.0) const;
 
 	bool IsSphere() const;
 
@@ -115,6 +159,7 @@ struct SphereNode : public Node
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 };
 
 
@@ -135,6 +180,7 @@ struct CapsuleNode : public Node
 	bool CollisionResolveVsRagdollNode(Node* node) override;
 
 	DoubleAABB3 GetBoundingBox() const override;
+	RaycastResult3D RaycastVsObject(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist) const override;
 };
 
 
@@ -156,6 +202,7 @@ struct Constraint
 	DoubleVec3 m_maxAngle;
 
 	int m_iteration = 1;
+	int m_constraintIndex = -1;		// creation order within its ragdoll, stable while others break
 
 	std::vector<Vertex_PCUTBN> m_vertexes;
 	std::vector<unsigned int> m_indexes;
@@ -171,6 +218,7 @@ struct Constraint
 	std::string GetName() const;
 
 	void Render() const;
+	void Render(DoubleVec3 const& position) const;
 };
 
 class Ragdoll
@@ -185,6 +233,17 @@ public:
 	void Render() const;
 	void Update(float deltaTime);
 
+	// Copies the node and constraint transforms into one of the two render snapshots.
+	// Render only ever reads Game::m_renderSnapshotIndex, so a step can publish into the other one
+	void PublishRenderSnapshot(int buffer);
+	void ReleaseBrokenConstraints();
+
+	// Everything a step reads or writes, for rollback and restarts from a saved world state.
+	// ParseState fails without changing anything if a constraint the state still has is broken here
+	void AppendState(BufferWriter& writer) const;
+	bool ParseState(BufferParser& parser);
+	static Ragdoll* CreateFromState(Game* game, BufferParser& parser);
+
 	void SolveOneIteration(float deltaTime);
 
 	// VERLET VELOCITY INTEGRATION
@@ -197,10 +256,12 @@ public:
 	void ApplyGlobalImpulseOnRoot(DoubleVec3 impulse);
 	void ApplyConstraints(float timeStep, int interation, bool fixedInteration = true);
 	void GetBoundingSphere(DoubleVec3& out_Center, double& out_radius);
+	double GetEnergy() const;
 
 	double GetAverageSpeedNodes() const;
 
 	void BreakNodeFromRagdoll(Node* n);
+	bool CanNodesCollide(int nodeIndexA, int nodeIndexB) const;
 
 
 	std::vector<Node*> GetNodeList() const;
@@ -220,6 +281,13 @@ public:
 	Rgba8 m_nodeColor = Rgba8::COLOR_RAGDOLL_NODE;
 	Rgba8 m_constraintColor = Rgba8::COLOR_RAGDOLL_CONSTRAINT;
 
+	int m_archetype = 0;
+	unsigned int m_spawnID = 0;		// unique per game session, names the ragdoll in replays
+	bool m_selfCollision = true;
+	RagdollCollisionFilter const* m_collisionFilter = nullptr;
+
+	int m_islandIndex = -1;		// only set while Octree::BuildContactIslands runs
+
 	bool m_isBreakable = false;
 	int m_brokenLimit = 0;
 	int m_brokenCount = 0;
@@ -240,6 +308,7 @@ private:
 	void CreateCapsuleNode();
 	void CreateTPose_CapsulesAndSpheres();
 	void CreateDebugNodes();
+	void BuildCollisionFilter();
 
 	Node* CreateRootNode(std::string name, DoubleVec3 offsetPositionToParent, double radius, double mass);
 	Node* CreateSphereNode(std::string name, Node* parent, DoubleVec3 offsetPositionToParent, double radius, double mass);
@@ -250,29 +319,16 @@ private:
 private:
 	std::vector<Node*> m_nodes;
 	std::vector<Constraint*> m_constraints;
+	std::vector<Constraint*> m_brokenConstraints;	// kept alive until the main thread syncs, the front snapshot may still draw them
 
+	RagdollRenderSnapshot m_renderSnapshots[2];
 };
 
-class RagdollPhysicsJob : public Job
-{
-public:
-	RagdollPhysicsJob(Ragdoll* ragdoll, float timeStep)
-		: m_ragdoll(ragdoll), m_timeStep(timeStep) {}
-
-	void Execute() override;
-
-	// Make these fields accessible for pooling
-	Ragdoll* m_ragdoll = nullptr;
-	float m_timeStep = (float)TIME_STEP;
-};
-
-
 void PushRagdollOutOfDefaultPlane3D_Double(Ragdoll* ragdoll);
 void PushRagdollOutOfAABB3D_Double(Ragdoll* ragdoll, DoubleAABB3& aabb);
 void PushRagdollOutOfOBB3D_Double(Ragdoll* ragdoll, DoubleOBB3& obb);
 void PushRagdollOutOfSphere3D_Double(Ragdoll* ragdoll, DoubleVec3& center, double radius);
 void PushRagdollOutOfCapsule3D_Double(Ragdoll* ragdoll, DoubleCapsule3& capsule);
-RaycastRagdollResult3D MouseRaycastVsRagdollNode(Camera* camera, Vec2 cursorPosition, Ragdoll* ragdoll);
 
 
 VelocityLessState StepVelocityLess(float timestep, const VelocityLessState& state, const DoubleVec3& torque, double angular_rate_damping = 1.0);
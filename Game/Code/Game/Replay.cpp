@@ -0,0 +1,498 @@
+#include "Game/Replay.hpp"
+#include "Game/Game.hpp"
+#include "Game/Ragdoll.hpp"
+#include "Engine/Core/FileUtils.hpp"
+
+// LEB128: seven bits a byte, so a node at rest costs one byte per delta
+static void AppendVarint(BufferWriter& writer, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		writer.AppendByte((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	writer.AppendByte((uint8_t)value);
+}
+
+static uint64_t ParseVarint(BufferParser& parser)
+{
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t byte = parser.ParseByte();
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) break;
+	}
+	return value;
+}
+
+// Zigzag keeps small negative deltas small
+static void AppendSignedVarint(BufferWriter& writer, int64_t value)
+{
+	AppendVarint(writer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static int64_t ParseSignedVarint(BufferParser& parser)
+{
+	uint64_t value = ParseVarint(parser);
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// The orientation deltas against the base only when the same component was dropped
+static void AppendSampleDelta(BufferWriter& writer, ReplayNodeSample const& sample, ReplayNodeSample const& base)
+{
+	bool isSameLargest = (sample.m_largestComponent == base.m_largestComponent);
+	for (int a = 0; a < 3; a++)
+	{
+		AppendSignedVarint(writer, (int64_t)sample.m_position[a] - base.m_position[a]);
+	}
+	writer.AppendByte((uint8_t)sample.m_largestComponent);
+	for (int a = 0; a < 3; a++)
+	{
+		AppendSignedVarint(writer, (int64_t)sample.m_components[a] - (isSameLargest ? base.m_components[a] : 0));
+	}
+}
+
+static void ParseSampleDelta(BufferParser& parser, ReplayNodeSample& out_sample, ReplayNodeSample const& base)
+{
+	for (int a = 0; a < 3; a++)
+	{
+		out_sample.m_position[a] = base.m_position[a] + (int)ParseSignedVarint(parser);
+	}
+	out_sample.m_largestComponent = parser.ParseByte();
+	bool isSameLargest = (out_sample.m_largestComponent == base.m_largestComponent);
+	for (int a = 0; a < 3; a++)
+	{
+		out_sample.m_components[a] = (isSameLargest ? base.m_components[a] : 0) + (int)ParseSignedVarint(parser);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+void ReplayNodeSample::Quantize(DoubleVec3 const& position, DoubleQuaternion const& orientation)
+{
+	m_position[0] = (int)floor(position.x / REPLAY_POSITION_QUANTUM + 0.5);
+	m_position[1] = (int)floor(position.y / REPLAY_POSITION_QUANTUM + 0.5);
+	m_position[2] = (int)floor(position.z / REPLAY_POSITION_QUANTUM + 0.5);
+
+	DoubleQuaternion q = orientation.GetNormalized();
+	double components[4] = { q.i, q.j, q.k, q.w };
+	m_largestComponent = 0;
+	for (int c = 1; c < 4; c++)
+	{
+		if (fabs(components[c]) > fabs(components[m_largestComponent]))
+		{
+			m_largestComponent = c;
+		}
+	}
+
+	// q and -q are the same rotation, so the dropped component can always be taken as positive
+	double sign = (components[m_largestComponent] < 0.0) ? -1.0 : 1.0;
+	int out = 0;
+	for (int c = 0; c < 4; c++)
+	{
+		if (c == m_largestComponent) continue;
+		m_components[out++] = (int)floor(components[c] * sign * REPLAY_QUATERNION_SCALE + 0.5);
+	}
+}
+
+DoubleVec3 ReplayNodeSample::GetPosition() const
+{
+	return DoubleVec3(m_position[0], m_position[1], m_position[2]) * REPLAY_POSITION_QUANTUM;
+}
+
+DoubleQuaternion ReplayNodeSample::GetOrientation() const
+{
+	double components[4] = {};
+	double sumSquared = 0.0;
+	int in = 0;
+	for (int c = 0; c < 4; c++)
+	{
+		if (c == m_largestComponent) continue;
+		components[c] = m_components[in++] / REPLAY_QUATERNION_SCALE;
+		sumSquared += components[c] * components[c];
+	}
+	components[m_largestComponent] = sqrt((sumSquared < 1.0) ? 1.0 - sumSquared : 0.0);
+	return DoubleQuaternion(components[0], components[1], components[2], components[3]);
+}
+
+//------------------------------------------------------------------------------------------------
+// Header: "RGRP", version, fixed step seconds. Then each frame is its byte size followed by:
+// keyframe flag, step, events, and per ragdoll its spawn ID, its archetype and colors the first
+// time it appears, its surviving constraints, and a delta-encoded sample per node
+bool ReplayRecorder::Start(std::string const& filePath, float stepSeconds)
+{
+	Stop();
+
+	std::vector<uint8_t> header;
+	BufferWriter writer(header);
+	writer.AppendChar('R');
+	writer.AppendChar('G');
+	writer.AppendChar('R');
+	writer.AppendChar('P');
+	writer.AppendUint32(REPLAY_VERSION);
+	writer.AppendFloat(stepSeconds);
+	if (!FileWriteFromBuffer(header, filePath)) return false;
+
+	m_filePath = filePath;
+	m_isRecording = true;
+	m_numFrames = 0;
+	m_numBytesRecorded = header.size();
+	m_events.clear();
+	m_previousRagdolls.clear();
+	return true;
+}
+
+void ReplayRecorder::Stop()
+{
+	if (!m_isRecording) return;
+
+	g_theJobSystem->Wait(m_writeCounter, JobPriority::BACKGROUND);	// the write job itself is background work
+	g_theJobSystem->ReleaseJob(m_writeJob);
+	m_writeJob = nullptr;
+
+	WritePendingBytes();
+	m_isRecording = false;
+}
+
+bool ReplayRecorder::IsRecording() const
+{
+	return m_isRecording;
+}
+
+int ReplayRecorder::GetNumFrames() const
+{
+	return m_numFrames;
+}
+
+size_t ReplayRecorder::GetNumBytesRecorded() const
+{
+	return m_numBytesRecorded;
+}
+
+void ReplayRecorder::RecordEvent(ReplayEvent const& event)
+{
+	if (!m_isRecording) return;
+
+	m_events.push_back(event);
+}
+
+void ReplayRecorder::RecordStep(int step, std::vector<Ragdoll*> const& ragdolls)
+{
+	if (!m_isRecording) return;
+
+	bool isKeyframe = (m_numFrames % REPLAY_KEYFRAME_INTERVAL) == 0;
+	if (isKeyframe)
+	{
+		m_previousRagdolls.clear();
+	}
+
+	m_frameBytes.clear();
+	BufferWriter writer(m_frameBytes);
+	writer.AppendUint32(0);		// frame size, filled in once the frame is written
+	writer.AppendBool(isKeyframe);
+	writer.AppendInt32(step);
+
+	AppendVarint(writer, m_events.size());
+	for (ReplayEvent const& event : m_events)
+	{
+		writer.AppendByte((uint8_t)event.m_type);
+		writer.AppendUint32(event.m_ragdollID);
+		writer.AppendVec3(event.m_vector);
+	}
+	m_events.clear();
+
+	std::map<unsigned int, ReplayRagdoll> currentRagdolls;
+	AppendVarint(writer, ragdolls.size());
+	for (Ragdoll* ragdoll : ragdolls)
+	{
+		auto previous = m_previousRagdolls.find(ragdoll->m_spawnID);
+		bool isNew = (previous == m_previousRagdolls.end());
+
+		ReplayRagdoll& recorded = currentRagdolls[ragdoll->m_spawnID];
+		recorded.m_archetype = ragdoll->m_archetype;
+		recorded.m_nodeColor = ragdoll->m_nodeColor;
+		recorded.m_constraintColor = ragdoll->m_constraintColor;
+		for (Constraint* c : ragdoll->GetConstraints())
+		{
+			recorded.m_constraintMask |= 1ull << c->m_constraintIndex;
+		}
+
+		std::vector<Node*> nodes = ragdoll->GetNodeList();
+		recorded.m_nodes.resize(nodes.size());
+
+		AppendVarint(writer, ragdoll->m_spawnID);
+		writer.AppendBool(isNew);
+		if (isNew)
+		{
+			writer.AppendByte((uint8_t)recorded.m_archetype);
+			writer.AppendRgba8(recorded.m_nodeColor);
+			writer.AppendRgba8(recorded.m_constraintColor);
+			AppendVarint(writer, nodes.size());
+		}
+		AppendVarint(writer, recorded.m_constraintMask);
+
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			recorded.m_nodes[i].Quantize(nodes[i]->m_position, nodes[i]->m_orientation);
+			ReplayNodeSample base;
+			if (!isNew && i < previous->second.m_nodes.size())
+			{
+				base = previous->second.m_nodes[i];
+			}
+			AppendSampleDelta(writer, recorded.m_nodes[i], base);
+		}
+	}
+	m_previousRagdolls.swap(currentRagdolls);
+	m_numFrames++;
+
+	writer.WriteIntToPos(0, (unsigned int)(m_frameBytes.size() - sizeof(unsigned int)));
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		m_pendingBytes.insert(m_pendingBytes.end(), m_frameBytes.begin(), m_frameBytes.end());
+		m_numBytesRecorded += m_frameBytes.size();
+		if (m_pendingBytes.size() < REPLAY_FLUSH_BYTES) return;
+	}
+	QueueWrite();
+}
+
+// At most one write is in flight. While it runs, frames pile up and the next flush takes them all
+void ReplayRecorder::QueueWrite()
+{
+	if (!m_writeCounter.IsDone()) return;
+
+	g_theJobSystem->ReleaseJob(m_writeJob);
+	m_writeJob = g_theJobSystem->CreateJob([this]() { WritePendingBytes(); });
+	m_writeJob->m_priority = JobPriority::BACKGROUND;
+	g_theJobSystem->QueueJobs(&m_writeJob, 1, m_writeCounter);
+}
+
+void ReplayRecorder::WritePendingBytes()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		m_writingBytes.swap(m_pendingBytes);
+	}
+	if (!m_writingBytes.empty())
+	{
+		FileAppendFromBuffer(m_writingBytes, m_filePath);
+	}
+	m_writingBytes.clear();
+}
+
+//------------------------------------------------------------------------------------------------
+bool ReplayPlayer::Load(Game* game, std::string const& filePath)
+{
+	Unload();
+	if (!HasFile(filePath)) return false;
+
+	FileReadToBuffer(m_bytes, filePath);
+	if (m_bytes.size() < 3 * sizeof(unsigned int))
+	{
+		Unload();
+		return false;
+	}
+
+	BufferParser parser(m_bytes);
+	bool isReplay = parser.ParseChar() == 'R' && parser.ParseChar() == 'G' && parser.ParseChar() == 'R' && parser.ParseChar() == 'P';
+	if (!isReplay || parser.ParseUint32() != REPLAY_VERSION)
+	{
+		Unload();
+		return false;
+	}
+	m_stepSeconds = parser.ParseFloat();
+
+	// A frame cut short, by a crash mid-write for one, ends the replay
+	size_t position = parser.GetCurReadPosition();
+	while (position + sizeof(unsigned int) <= m_bytes.size())
+	{
+		parser.SetCurReadPosition(position);
+		size_t frameStart = position + sizeof(unsigned int);
+		size_t frameEnd = frameStart + parser.ParseUint32();
+		if (frameEnd > m_bytes.size()) break;
+
+		m_frameOffsets.push_back(frameStart);
+		position = frameEnd;
+	}
+
+	if (m_frameOffsets.empty())
+	{
+		Unload();
+		return false;
+	}
+
+	m_game = game;
+	SeekToFrame(0);
+	return true;
+}
+
+void ReplayPlayer::Unload()
+{
+	for (auto& displayRagdoll : m_displayRagdolls)
+	{
+		delete displayRagdoll.second;
+	}
+	m_displayRagdolls.clear();
+
+	m_bytes.clear();
+	m_frameOffsets.clear();
+	m_currentFrame = -1;
+	m_currentStep = 0;
+	m_currentEvents.clear();
+	m_currentRagdolls.clear();
+}
+
+bool ReplayPlayer::IsLoaded() const
+{
+	return !m_frameOffsets.empty();
+}
+
+int ReplayPlayer::GetNumFrames() const
+{
+	return (int)m_frameOffsets.size();
+}
+
+int ReplayPlayer::GetCurrentFrame() const
+{
+	return m_currentFrame;
+}
+
+int ReplayPlayer::GetCurrentStep() const
+{
+	return m_currentStep;
+}
+
+float ReplayPlayer::GetStepSeconds() const
+{
+	return m_stepSeconds;
+}
+
+std::vector<ReplayEvent> const& ReplayPlayer::GetCurrentEvents() const
+{
+	return m_currentEvents;
+}
+
+void ReplayPlayer::SeekToFrame(int frame)
+{
+	if (!IsLoaded()) return;
+
+	frame = Clamp(frame, 0, GetNumFrames() - 1);
+	if (frame == m_currentFrame) return;
+
+	// Playing forward decodes one frame at a time; anything else restarts from the keyframe
+	int keyframe = (frame / REPLAY_KEYFRAME_INTERVAL) * REPLAY_KEYFRAME_INTERVAL;
+	int firstFrame = (m_currentFrame >= keyframe && m_currentFrame < frame) ? m_currentFrame + 1 : keyframe;
+	for (int f = firstFrame; f <= frame; f++)
+	{
+		DecodeFrame(f);
+	}
+
+	for (auto& recorded : m_currentRagdolls)
+	{
+		GetOrCreateRagdoll(recorded.first, recorded.second);
+	}
+}
+
+void ReplayPlayer::DecodeFrame(int frame)
+{
+	BufferParser parser(m_bytes);
+	parser.SetCurReadPosition(m_frameOffsets[frame]);
+
+	bool isKeyframe = parser.ParseBool();
+	if (isKeyframe)
+	{
+		m_currentRagdolls.clear();
+	}
+	m_currentStep = parser.ParseInt32();
+
+	m_currentEvents.resize((size_t)ParseVarint(parser));
+	for (ReplayEvent& event : m_currentEvents)
+	{
+		event.m_type = (ReplayEventType)parser.ParseByte();
+		event.m_ragdollID = parser.ParseUint32();
+		event.m_vector = parser.ParseVec3();
+	}
+
+	std::map<unsigned int, ReplayRagdoll> ragdolls;
+	uint64_t numRagdolls = ParseVarint(parser);
+	for (uint64_t r = 0; r < numRagdolls; r++)
+	{
+		unsigned int ragdollID = (unsigned int)ParseVarint(parser);
+		bool isNew = parser.ParseBool();
+		auto previous = m_currentRagdolls.find(ragdollID);
+
+		ReplayRagdoll& decoded = ragdolls[ragdollID];
+		if (isNew)
+		{
+			decoded.m_archetype = parser.ParseByte();
+			decoded.m_nodeColor = parser.ParseRgba8();
+			decoded.m_constraintColor = parser.ParseRgba8();
+			decoded.m_nodes.resize((size_t)ParseVarint(parser));
+		}
+		else
+		{
+			GUARANTEE_OR_DIE(previous != m_currentRagdolls.end(), Stringf("Replay frame %i deltas against ragdoll %u, which the previous frame does not have", frame, ragdollID));
+			decoded.m_archetype = previous->second.m_archetype;
+			decoded.m_nodeColor = previous->second.m_nodeColor;
+			decoded.m_constraintColor = previous->second.m_constraintColor;
+			decoded.m_nodes.resize(previous->second.m_nodes.size());
+		}
+		decoded.m_constraintMask = ParseVarint(parser);
+
+		for (size_t i = 0; i < decoded.m_nodes.size(); i++)
+		{
+			ReplayNodeSample base;
+			if (!isNew)
+			{
+				base = previous->second.m_nodes[i];
+			}
+			ParseSampleDelta(parser, decoded.m_nodes[i], base);
+		}
+	}
+	m_currentRagdolls.swap(ragdolls);
+	m_currentFrame = frame;
+}
+
+Ragdoll* ReplayPlayer::GetOrCreateRagdoll(unsigned int ragdollID, ReplayRagdoll const& recorded)
+{
+	auto found = m_displayRagdolls.find(ragdollID);
+	if (found != m_displayRagdolls.end()) return found->second;
+
+	// Building a ragdoll rolls the RNG, which the live simulation must not notice
+	RandomNumberGenerator rngState = *g_theRNG;
+	Ragdoll* ragdoll = new Ragdoll(m_game, DoubleMat44(), 5.f, VerletConfig(), recorded.m_archetype, recorded.m_nodeColor, recorded.m_constraintColor);
+	*g_theRNG = rngState;
+
+	m_displayRagdolls[ragdollID] = ragdoll;
+	return ragdoll;
+}
+
+void ReplayPlayer::Render() const
+{
+	for (auto& recorded : m_currentRagdolls)
+	{
+		auto found = m_displayRagdolls.find(recorded.first);
+		if (found == m_displayRagdolls.end()) continue;
+
+		std::vector<ReplayNodeSample> const& samples = recorded.second.m_nodes;
+		std::vector<Node*> nodes = found->second->GetNodeList();
+		for (size_t i = 0; i < nodes.size() && i < samples.size(); i++)
+		{
+			NodeRenderState state;
+			state.m_position = samples[i].GetPosition();
+			state.m_orientation = samples[i].GetOrientation();
+			state.m_previousPosition = state.m_position;
+			state.m_previousOrientation = state.m_orientation;
+			nodes[i]->Render(state);
+		}
+
+		for (Constraint* c : found->second->GetConstraints())
+		{
+			if ((recorded.second.m_constraintMask & (1ull << c->m_constraintIndex)) == 0) continue;
+			if (c->nA->m_nodeIndex >= (int)samples.size() || c->nB->m_nodeIndex >= (int)samples.size()) continue;
+
+			DoubleVec3 positionA = samples[c->nA->m_nodeIndex].GetPosition();
+			DoubleVec3 positionB = samples[c->nB->m_nodeIndex].GetPosition();
+			c->Render((positionA + positionB) * 0.5);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include <map>
+#include <mutex>
+
+class Game;
+class Ragdoll;
+class BufferWriter;
+class BufferParser;
+
+constexpr unsigned int REPLAY_VERSION = 1;
+constexpr double REPLAY_POSITION_QUANTUM = 1.0 / 1024.0;	// meters per quantized position step
+constexpr double REPLAY_QUATERNION_SCALE = 32767.0 * 1.41421356237;	// the three smallest components fit in [-1/sqrt2, 1/sqrt2]
+constexpr int REPLAY_KEYFRAME_INTERVAL = 120;				// frames between frames that do not delta against the previous one
+constexpr size_t REPLAY_FLUSH_BYTES = 64 * 1024;			// pending bytes before a background write is queued
+
+enum class ReplayEventType : uint8_t
+{
+	SPAWN,		// m_vector is the spawn position
+	PUSH,		// m_vector is the acceleration applied from input
+	DESPAWN,
+};
+
+struct ReplayEvent
+{
+	ReplayEventType m_type = ReplayEventType::SPAWN;
+	unsigned int m_ragdollID = 0;
+	Vec3 m_vector;
+};
+
+// One node as stored in the stream: a quantized position, and the orientation as its largest
+// component's index plus the other three quantized ("smallest three")
+struct ReplayNodeSample
+{
+	int m_position[3] = {};
+	int m_largestComponent = 3;
+	int m_components[3] = {};
+
+	void Quantize(DoubleVec3 const& position, DoubleQuaternion const& orientation);
+	DoubleVec3 GetPosition() const;
+	DoubleQuaternion GetOrientation() const;
+};
+
+struct ReplayRagdoll
+{
+	int m_archetype = 0;
+	Rgba8 m_nodeColor;
+	Rgba8 m_constraintColor;
+	uint64_t m_constraintMask = 0;		// bit per surviving constraint, by Constraint::m_constraintIndex
+	std::vector<ReplayNodeSample> m_nodes;
+};
+
+//------------------------------------------------------------------------------------------------
+// Records one frame per fixed step. Frames are encoded where the step finishes and handed to a
+// background job that appends them to the file, so recording never waits on the disk.
+// RecordEvent and RecordStep must not overlap; the game calls them on either side of its step sync.
+class ReplayRecorder
+{
+public:
+	ReplayRecorder() = default;
+	~ReplayRecorder() = default;
+
+	bool Start(std::string const& filePath, float stepSeconds);
+	void Stop();
+	bool IsRecording() const;
+	int GetNumFrames() const;
+	size_t GetNumBytesRecorded() const;
+
+	void RecordEvent(ReplayEvent const& event);
+	void RecordStep(int step, std::vector<Ragdoll*> const& ragdolls);
+
+private:
+	void QueueWrite();
+	void WritePendingBytes();
+
+private:
+	std::string m_filePath;
+	bool m_isRecording = false;
+	int m_numFrames = 0;
+	size_t m_numBytesRecorded = 0;
+
+	std::vector<ReplayEvent> m_events;
+	std::map<unsigned int, ReplayRagdoll> m_previousRagdolls;
+	std::vector<uint8_t> m_frameBytes;
+
+	std::mutex m_pendingMutex;
+	std::vector<uint8_t> m_pendingBytes;
+	std::vector<uint8_t> m_writingBytes;	// only touched by the write job in flight
+	FunctionJob* m_writeJob = nullptr;
+	JobCounter m_writeCounter;
+};
+
+//------------------------------------------------------------------------------------------------
+// Shows a recorded stream frame by frame without simulating. Load indexes every frame once, and
+// SeekToFrame decodes forward from the nearest keyframe at or before the target.
+class ReplayPlayer
+{
+public:
+	ReplayPlayer() = default;
+	~ReplayPlayer() = default;
+
+	bool Load(Game* game, std::string const& filePath);
+	void Unload();
+	bool IsLoaded() const;
+
+	int GetNumFrames() const;
+	int GetCurrentFrame() const;
+	int GetCurrentStep() const;
+	float GetStepSeconds() const;
+	std::vector<ReplayEvent> const& GetCurrentEvents() const;
+
+	void SeekToFrame(int frame);
+	void Render() const;
+
+private:
+	void DecodeFrame(int frame);
+	Ragdoll* GetOrCreateRagdoll(unsigned int ragdollID, ReplayRagdoll const& recorded);
+
+private:
+	Game* m_game = nullptr;
+	std::vector<uint8_t> m_bytes;
+	std::vector<size_t> m_frameOffsets;
+	float m_stepSeconds = 0.f;
+
+	int m_currentFrame = -1;
+	int m_currentStep = 0;
+	std::vector<ReplayEvent> m_currentEvents;
+	std::map<unsigned int, ReplayRagdoll> m_currentRagdolls;
+	std::map<unsigned int, Ragdoll*> m_displayRagdolls;		// built once per recorded ragdoll, never simulated
+};